@@ -68,22 +68,31 @@ CffiGetEncodingFromObj(Tcl_Interp *ip, Tcl_Obj *encObj, Tcl_Encoding *encP)
     return TCL_OK;
 }
 
+/* Function: CffiFunctionFromPointerObj
+ * Constructs a function descriptor from a function pointer.
+ *
+ * Parameters:
+ * ipCtxP - interpreter context
+ * fnPtrObj - pointer value tagged with a prototype name
+ * fnPP - location to store the function descriptor. Its reference count
+ *    is 0 and the caller is responsible for managing it.
+ *
+ * Returns:
+ * Returns TCL_OK on success and TCL_ERROR on failure with error message
+ * in the interpreter.
+ */
 static CffiResult
-CffiCallObjCmd(ClientData cdata,
-               Tcl_Interp *ip,
-               int objc,
-               Tcl_Obj *const objv[])
+CffiFunctionFromPointerObj(CffiInterpCtx *ipCtxP,
+                           Tcl_Obj *fnPtrObj,
+                           CffiFunction **fnPP)
 {
+    Tcl_Interp *ip = ipCtxP->interp;
     Tcl_Obj *protoNameObj;
-    CffiInterpCtx *ipCtxP = (CffiInterpCtx *)cdata;
     CffiProto *protoP;
-    CffiFunction *fnP;
-    CffiResult ret;
     void *fnAddr;
 
-    CHECK_NARGS(ip, 2, INT_MAX, "FNPTR ?ARG ...?");
-    CHECK(Tclh_PointerObjGetTag(ip, objv[1], &protoNameObj));
-    CHECK(Tclh_PointerUnwrap(ip, objv[1], &fnAddr));
+    CHECK(Tclh_PointerObjGetTag(ip, fnPtrObj, &protoNameObj));
+    CHECK(Tclh_PointerUnwrap(ip, fnPtrObj, &fnAddr));
 
     protoNameObj = Tclh_NsQualifyNameObj(ip, protoNameObj, NULL);
     Tcl_IncrRefCount(protoNameObj);
@@ -93,10 +102,55 @@ CffiCallObjCmd(ClientData cdata,
 
     if (protoP == NULL) {
         return Tclh_ErrorNotFound(
-            ip, "Prototype", objv[1], "Function prototype not found.");
+            ip, "Prototype", fnPtrObj, "Function prototype not found.");
+    }
+
+    *fnPP = CffiFunctionNew(ipCtxP, protoP, NULL, NULL, fnAddr);
+    return TCL_OK;
+}
+
+/* Function: CffiFunctionFromObj
+ * Returns the function descriptor for a wrapped function or function pointer.
+ *
+ * Parameters:
+ * ipCtxP - interpreter context
+ * fnObj - name of a command defined through the *function* or *stdcall*
+ *    methods of a *Wrapper*, or a pointer value tagged with a prototype name
+ * fnPP - location to store the function descriptor. The caller must
+ *    reference it with <CffiFunctionRef> and release it with
+ *    <CffiFunctionUnref>.
+ *
+ * Returns:
+ * Returns TCL_OK on success and TCL_ERROR on failure with error message
+ * in the interpreter.
+ */
+CffiResult
+CffiFunctionFromObj(CffiInterpCtx *ipCtxP, Tcl_Obj *fnObj, CffiFunction **fnPP)
+{
+    Tcl_CmdInfo cmdInfo;
+
+    /* Prefer a wrapped function command, else a function pointer */
+    if (Tcl_GetCommandInfo(ipCtxP->interp, Tcl_GetString(fnObj), &cmdInfo)
+        && cmdInfo.objProc == CffiFunctionInstanceCmd) {
+        *fnPP = (CffiFunction *)cmdInfo.objClientData;
+        return TCL_OK;
     }
+    return CffiFunctionFromPointerObj(ipCtxP, fnObj, fnPP);
+}
+
+static CffiResult
+CffiCallObjCmd(ClientData cdata,
+               Tcl_Interp *ip,
+               int objc,
+               Tcl_Obj *const objv[])
+{
+    CffiInterpCtx *ipCtxP = (CffiInterpCtx *)cdata;
+    CffiFunction *fnP;
+    CffiResult ret;
+
+    CHECK_NARGS(ip, 2, INT_MAX, "FNPTR ?ARG ...?");
+    CHECK(CffiFunctionFromPointerObj(ipCtxP, objv[1], &fnP));
 
-    fnP = CffiFunctionNew(ipCtxP, protoP, NULL, NULL, fnAddr);
     CffiFunctionRef(fnP);
     ret = CffiFunctionCall(fnP, ip, 2, objc, objv);
     CffiFunctionUnref(fnP);
@@ -104,6 +158,205 @@ CffiCallObjCmd(ClientData cdata,
     return ret;
 }
 
+/* Function: CffiBatchObjCmd
+ * Implements the *cffi::batch* script level command.
+ *
+ * Parameters:
+ * cdata - interpreter context
+ * ip - interpreter
+ * objc - number of elements in *objv*
+ * objv - array containing the command and arguments
+ *
+ * The syntax is
+ *   batch ?-columns? ?-collect? FUNCTION ARGLISTS
+ * where FUNCTION is either a command defined through the *function* or
+ * *stdcall* methods of a *Wrapper* or a function pointer as accepted by
+ * *cffi::call*. ARGLISTS is a list of argument lists, one per call, or if
+ * the -columns option is specified, a list of columns each containing the
+ * values of one argument for every call.
+ *
+ * The function is invoked once per argument list directly from C, without
+ * going through Tcl command dispatch. By default the command fails on the
+ * first error. With -collect, each element of the result is a pair
+ * consisting of the return code and result of the corresponding call.
+ *
+ * Returns:
+ * Returns TCL_OK on success and TCL_ERROR on failure with error message
+ * in the interpreter. On success, the interpreter result is the list of
+ * function results.
+ */
+static CffiResult
+CffiBatchObjCmd(ClientData cdata,
+                Tcl_Interp *ip,
+                int objc,
+                Tcl_Obj *const objv[])
+{
+    CffiInterpCtx *ipCtxP = (CffiInterpCtx *)cdata;
+    CffiFunction *fnP;
+    Tcl_Obj *argListsObj;
+    Tcl_Obj *resultsObj;
+    Tcl_Obj **colObjs = NULL;
+    Tcl_Obj **callObjs;
+    Tcl_Obj **argObjs;
+    Tcl_Size nCols = 0;
+    Tcl_Size nCalls;
+    Tcl_Size nArgs;
+    Tcl_Size maxArgs;
+    Tcl_Size i, j;
+    Tclh_LifoMark mark;
+    int columns = 0;
+    int collect = 0;
+    CffiResult ret = TCL_OK;
+    enum Opts { COLUMNS, COLLECT };
+    static const char *const opts[] = {"-columns", "-collect", NULL};
+
+    for (i = 1; i < objc - 2; ++i) {
+        int optIndex;
+        CHECK(Tcl_GetIndexFromObj(ip, objv[i], opts, "option", 0, &optIndex));
+        switch (optIndex) {
+        case COLUMNS: columns = 1; break;
+        case COLLECT: collect = 1; break;
+        }
+    }
+    CHECK_NARGS(ip, i + 2, i + 2, "?-columns? ?-collect? FUNCTION ARGLISTS");
+
+    CHECK(CffiFunctionFromObj(ipCtxP, objv[i], &fnP));
+
+    /* Hold references as the function may call back into the interpreter */
+    CffiFunctionRef(fnP);
+    argListsObj = objv[i + 1];
+    Tcl_IncrRefCount(argListsObj);
+    mark = Tclh_LifoPushMark(&ipCtxP->memlifo);
+
+    if (columns) {
+        Tcl_Obj **objs;
+        ret = Tcl_ListObjGetElements(ip, argListsObj, &nCols, &objs);
+        if (ret != TCL_OK)
+            goto vamoose;
+        /* Copy as column list may shimmer in callbacks */
+        colObjs = Tclh_LifoAlloc(&ipCtxP->memlifo, (nCols + 1) * sizeof(Tcl_Obj *));
+        nCalls  = 0;
+        for (j = 0; j < nCols; ++j) {
+            Tcl_Size n;
+            colObjs[j] = objs[j];
+            Tcl_IncrRefCount(colObjs[j]);
+            ret = Tcl_ListObjLength(ip, colObjs[j], &n);
+            if (ret != TCL_OK) {
+                ++j; /* So this one is released as well */
+                goto release_columns;
+            }
+            if (j == 0)
+                nCalls = n;
+            else if (n != nCalls) {
+                ++j;
+                ret = Tclh_ErrorInvalidValue(
+                    ip, colObjs[j - 1], "Columns differ in length.");
+                goto release_columns;
+            }
+        }
+        maxArgs = nCols;
+    }
+    else {
+        ret = Tcl_ListObjLength(ip, argListsObj, &nCalls);
+        if (ret != TCL_OK)
+            goto vamoose;
+        maxArgs = fnP->protoP->nParams + 1; /* Grown if needed */
+    }
+    /*
+     * The function name is passed ahead of the arguments so argument count
+     * errors show the same syntax as a direct call.
+     */
+    callObjs =
+        Tclh_LifoAlloc(&ipCtxP->memlifo, (maxArgs + 1) * sizeof(Tcl_Obj *));
+    callObjs[0] = objv[objc - 2];
+    argObjs     = callObjs + 1;
+
+    resultsObj = Tcl_NewListObj(nCalls, NULL);
+    Tcl_IncrRefCount(resultsObj);
+    for (i = 0; i < nCalls; ++i) {
+        CffiResult callRet;
+        Tcl_Obj *objP;
+
+        /*
+         * Each call receives its own references to its arguments as the
+         * containing lists may shimmer if the function calls back into
+         * the interpreter.
+         */
+        if (columns) {
+            for (j = 0; j < nCols; ++j) {
+                ret = Tcl_ListObjIndex(ip, colObjs[j], i, &argObjs[j]);
+                if (ret == TCL_OK && argObjs[j] == NULL) {
+                    ret = Tclh_ErrorInvalidValue(
+                        ip, colObjs[j], "Columns differ in length.");
+                }
+                if (ret != TCL_OK)
+                    break;
+                Tcl_IncrRefCount(argObjs[j]);
+            }
+            if (ret != TCL_OK) {
+                while (j-- > 0)
+                    Tcl_DecrRefCount(argObjs[j]);
+                break;
+            }
+            nArgs = nCols;
+        }
+        else {
+            Tcl_Obj **objs;
+            ret = Tcl_ListObjIndex(ip, argListsObj, i, &objP);
+            if (ret == TCL_OK)
+                ret = Tcl_ListObjGetElements(ip, objP, &nArgs, &objs);
+            if (ret != TCL_OK)
+                break;
+            if (nArgs > maxArgs) {
+                maxArgs  = nArgs;
+                callObjs = Tclh_LifoAlloc(&ipCtxP->memlifo,
+                                          (maxArgs + 1) * sizeof(Tcl_Obj *));
+                callObjs[0] = objv[objc - 2];
+                argObjs     = callObjs + 1;
+            }
+            for (j = 0; j < nArgs; ++j) {
+                argObjs[j] = objs[j];
+                Tcl_IncrRefCount(argObjs[j]);
+            }
+        }
+
+        Tcl_ResetResult(ip); /* Functions with discard do not set result */
+        callRet = CffiFunctionCall(fnP, ip, 1, (int)nArgs + 1, callObjs);
+
+        for (j = 0; j < nArgs; ++j)
+            Tcl_DecrRefCount(argObjs[j]);
+
+        if (collect) {
+            Tcl_Obj *pairObjs[2];
+            pairObjs[0] = Tcl_NewIntObj(callRet);
+            pairObjs[1] = Tcl_GetObjResult(ip);
+            Tcl_ListObjAppendElement(NULL, resultsObj, Tcl_NewListObj(2, pairObjs));
+        }
+        else if (callRet == TCL_OK) {
+            Tcl_ListObjAppendElement(NULL, resultsObj, Tcl_GetObjResult(ip));
+        }
+        else {
+            Tcl_AppendObjToErrorInfo(
+                ip, Tcl_ObjPrintf("\n    (batch call %d)", (int)i));
+            ret = TCL_ERROR;
+            break;
+        }
+    }
+    if (ret == TCL_OK)
+        Tcl_SetObjResult(ip, resultsObj);
+    Tcl_DecrRefCount(resultsObj);
+
+    j = nCols;
+release_columns:
+    while (j-- > 0)
+        Tcl_DecrRefCount(colObjs[j]);
+vamoose:
+    Tclh_LifoPopMark(mark);
+    Tcl_DecrRefCount(argListsObj);
+    CffiFunctionUnref(fnP);
+    return ret;
+}
+
 static CffiResult
 CffiLimitsObjCmd(ClientData cdata,
                   Tcl_Interp *ip,
@@ -240,6 +493,9 @@ CffiClosureDeleteEntry(Tcl_HashTable *htP, Tcl_HashEntry *heP, ClientData unused
 static void
 CffiInterpCtxCleanupAndFree(CffiInterpCtx *ipCtxP)
 {
+        /* Must be first as pending calls reference functions and prototypes */
+        CffiAsyncFinit(ipCtxP);
+        CffiStatsFinit(ipCtxP);
 #ifdef CFFI_USE_LIBFFI
         CffiLibffiFinit(ipCtxP);
 #endif
@@ -253,6 +509,8 @@ CffiInterpCtxCleanupAndFree(CffiInterpCtx *ipCtxP)
         Tclh_HashIterate(
             &ipCtxP->callbackClosures, CffiClosureDeleteEntry, NULL);
         Tcl_DeleteHashTable(&ipCtxP->callbackClosures);
+        Tcl_DeleteHashTable(&ipCtxP->pooledBlocks);
+        Tcl_DeleteHashTable(&ipCtxP->pointerWatches);
 
         CffiArenaFinit(ipCtxP);
 
@@ -295,6 +553,12 @@ CffiInterpCtxAllocAndInit(Tcl_Interp *ip, CffiInterpCtx **ipCtxPP)
     /* Table mapping callback closure function addresses to CffiCallback */
     Tcl_InitHashTable(&ipCtxP->callbackClosures, TCL_ONE_WORD_KEYS);
 
+    /* Table of pooled struct allocations currently in use */
+    Tcl_InitHashTable(&ipCtxP->pooledBlocks, TCL_ONE_WORD_KEYS);
+
+    /* Table of safe struct views keyed by the pointer they are bound to */
+    Tcl_InitHashTable(&ipCtxP->pointerWatches, TCL_ONE_WORD_KEYS);
+
 #ifdef CFFI_USE_DYNCALL
     ret = CffiDyncallInit(ipCtxP);
 #endif
@@ -366,12 +630,18 @@ Cffi_Init(Tcl_Interp *ip)
         ip, CFFI_NAMESPACE "::Interface", CffiInterfaceObjCmd, ipCtxP, NULL);
     Tcl_CreateObjCommand(
         ip, CFFI_NAMESPACE "::call", CffiCallObjCmd, ipCtxP, NULL);
+    Tcl_CreateObjCommand(
+        ip, CFFI_NAMESPACE "::batch", CffiBatchObjCmd, ipCtxP, NULL);
+    Tcl_CreateObjCommand(
+        ip, CFFI_NAMESPACE "::async", CffiAsyncObjCmd, ipCtxP, NULL);
 #ifdef CFFI_HAVE_CALLBACKS
     Tcl_CreateObjCommand(
         ip, CFFI_NAMESPACE "::callback", CffiCallbackObjCmd, ipCtxP, NULL);
 #endif
     Tcl_CreateObjCommand(
         ip, CFFI_NAMESPACE "::prototype", CffiPrototypeObjCmd, ipCtxP, NULL);
+    Tcl_CreateObjCommand(
+        ip, CFFI_NAMESPACE "::stats", CffiStatsObjCmd, ipCtxP, NULL);
     Tcl_CreateObjCommand(
         ip, CFFI_NAMESPACE "::memory", CffiMemoryObjCmd, ipCtxP, NULL);
     Tcl_CreateObjCommand(
@@ -390,6 +660,8 @@ Cffi_Init(Tcl_Interp *ip)
         ip, CFFI_NAMESPACE "::arena", CffiArenaObjCmd, ipCtxP, NULL);
     Tcl_CreateObjCommand(
         ip, CFFI_NAMESPACE "::savederrors", CffiSavedErrorsObjCmd, ipCtxP, NULL);
+    Tcl_CreateObjCommand(
+        ip, CFFI_NAMESPACE "::vector", CffiVectorObjCmd, ipCtxP, NULL);
     Tcl_CreateObjCommand(
         ip, CFFI_NAMESPACE "::sandbox", CffiSandboxObjCmd, NULL, NULL);
 
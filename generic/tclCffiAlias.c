@@ -181,9 +181,12 @@ CffiAliasAdd(CffiInterpCtx *ipCtxP,
         ckfree(typeAttrsP);
     }
 
-    if (ret == TCL_OK && fqnObjP) {
-        CFFI_ASSERT(fqnObj);
-        *fqnObjP = fqnObj;
+    if (ret == TCL_OK) {
+        ipCtxP->typeEpoch += 1; /* Invalidate cached type parses */
+        if (fqnObjP) {
+            CFFI_ASSERT(fqnObj);
+            *fqnObjP = fqnObj;
+        }
     }
 
     return ret;
@@ -319,6 +322,7 @@ CffiAliasDeleteCmd(CffiInterpCtx *ipCtxP,
                     Tcl_Obj *const objv[])
 {
     CFFI_ASSERT(objc == 3);
+    ipCtxP->typeEpoch += 1; /* Invalidate cached type parses */
     return CffiNameDeleteNames(ipCtxP->interp,
                                &ipCtxP->scope.aliases,
                                Tcl_GetString(objv[2]),
@@ -332,6 +336,7 @@ CffiAliasClearCmd(CffiInterpCtx *ipCtxP,
                   Tcl_Obj *const objv[])
 {
     CFFI_ASSERT(objc == 2);
+    ipCtxP->typeEpoch += 1; /* Invalidate cached type parses */
     return CffiNameDeleteNames(ipCtxP->interp,
                                &ipCtxP->scope.aliases,
                                NULL,
@@ -134,6 +134,7 @@ CffiArenaPopFrame(CffiInterpCtx *ipCtxP)
          arenaLinkP = arenaLinkP->prevAllocationP) {
         void *p = ARENA_ALLOCATION_LINK_SIZE + (char *)arenaLinkP;
         (void)Tclh_PointerUnregister(ipCtxP->interp, ipCtxP->tclhCtxP, p);
+        CffiPointerWatchesInvalidate(ipCtxP, p);
     }
     Tclh_LifoPopFrame(&ipCtxP->arenaStore);
     return TCL_OK;
@@ -0,0 +1,580 @@
+/*
+ * Copyright (c) 2024 Ashok P. Nadkarni
+ * All rights reserved.
+ *
+ * See the file LICENSE for license
+ */
+
+#include "tclCffiInt.h"
+
+/*
+ * Asynchronous function calls.
+ *
+ * Arguments are converted to native form in the interpreter thread. The
+ * call is then queued to a pool of worker threads shared by all
+ * interpreters in the process. On completion, the worker queues a Tcl
+ * event back to the interpreter thread which wraps the result and invokes
+ * the script level callback. The workers are terminated and joined by an
+ * exit handler at process exit.
+ *
+ * Only functions whose call plans are marked CFFI_F_PLAN_SCALAR are
+ * permitted. Their parameters are numeric or pointer values passed by
+ * value and their return values are void or numeric so nothing needs to
+ * be accessed in the interpreter from the worker thread and no memlifo
+ * storage needs to survive the initiating command.
+ */
+
+#define CFFI_K_ASYNC_MAX_WORKERS 4
+
+typedef struct CffiAsyncCall {
+    struct CffiAsyncCall *nextP; /* Next call in the pending queue */
+    CffiInterpCtx *ipCtxP;       /* Context of initiating interpreter */
+    Tcl_ThreadId threadId;       /* Thread of initiating interpreter */
+    CffiFunction *fnP;           /* Function to call */
+    Tcl_Obj *cmdObj;             /* Callback command prefix */
+    CffiValue retValue;          /* Function return value */
+    CffiValue argValues[CFFI_K_MAX_SCALAR_PARAMS]; /* Native argument values */
+#ifdef CFFI_USE_LIBFFI
+    void *argValuesP[CFFI_K_MAX_SCALAR_PARAMS]; /* Pointers to argValues[] */
+#endif
+} CffiAsyncCall;
+
+typedef struct CffiAsyncEvent {
+    Tcl_Event header; /* Must be first */
+    CffiAsyncCall *asyncP;
+} CffiAsyncEvent;
+
+/*
+ * Worker pool state. All protected by cffiAsyncMutex. The counts of
+ * pending calls in each interpreter context are also protected by it.
+ */
+TCL_DECLARE_MUTEX(cffiAsyncMutex)
+static Tcl_Condition cffiAsyncQueueCond; /* Signalled when calls are queued */
+static CffiAsyncCall *cffiAsyncQueueHeadP;
+static CffiAsyncCall *cffiAsyncQueueTailP;
+static int cffiAsyncNumWorkers;
+static int cffiAsyncNumIdle;
+static int cffiAsyncShutdown; /* Set at process exit to terminate workers */
+static Tcl_ThreadId cffiAsyncWorkerIds[CFFI_K_ASYNC_MAX_WORKERS];
+
+/* Function: CffiAsyncCallFree
+ * Releases the resources held by an asynchronous call.
+ *
+ * Parameters:
+ * asyncP - call to free. Must not be in the pending queue.
+ *
+ * Must be called from the interpreter thread.
+ */
+static void
+CffiAsyncCallFree(CffiAsyncCall *asyncP)
+{
+    CffiFunctionUnref(asyncP->fnP);
+    Tcl_DecrRefCount(asyncP->cmdObj);
+    ckfree(asyncP);
+}
+
+/* Function: CffiAsyncInvoke
+ * Invokes the function for an asynchronous call.
+ *
+ * Parameters:
+ * asyncP - call to invoke. The return value is stored in asyncP->retValue.
+ * vmP - dyncall call context private to the worker thread (dyncall only)
+ *
+ * Called in a worker thread so must not access the interpreter. In
+ * particular, the dyncall context of the interpreter cannot be used.
+ */
+static void
+#ifdef CFFI_USE_LIBFFI
+CffiAsyncInvoke(CffiAsyncCall *asyncP)
+#endif
+#ifdef CFFI_USE_DYNCALL
+CffiAsyncInvoke(CffiAsyncCall *asyncP, DCCallVM *vmP)
+#endif
+{
+    CffiProto *protoP = asyncP->fnP->protoP;
+
+#ifdef CFFI_USE_LIBFFI
+    CffiCall callCtx;
+
+    callCtx.fnP         = asyncP->fnP;
+    callCtx.cifP        = protoP->cifP;
+    callCtx.argValuesPP = asyncP->argValuesP;
+    callCtx.retValueP   = &callCtx.retValue.u;
+    callCtx.nArgs       = protoP->nParams;
+    callCtx.argsP       = NULL;
+
+#define CALL_(fld_, cffifn_, dcfn_) asyncP->retValue.u.fld_ = cffifn_(&callCtx)
+#define CALLVOID_() CffiCallVoidFunc(&callCtx)
+#endif
+
+#ifdef CFFI_USE_DYNCALL
+    void *fnAddr = asyncP->fnP->fnAddr;
+    int i;
+
+    dcMode(vmP, protoP->abi);
+    dcReset(vmP);
+    for (i = 0; i < protoP->nParams; ++i) {
+        CffiValue *valueP = &asyncP->argValues[i];
+        switch (protoP->params[i].typeAttrs.dataType.baseType) {
+        case CFFI_K_TYPE_SCHAR: dcArgChar(vmP, valueP->u.schar); break;
+        case CFFI_K_TYPE_UCHAR: dcArgChar(vmP, valueP->u.uchar); break;
+        case CFFI_K_TYPE_SHORT: dcArgShort(vmP, valueP->u.sshort); break;
+        case CFFI_K_TYPE_USHORT: dcArgShort(vmP, valueP->u.ushort); break;
+        case CFFI_K_TYPE_INT: dcArgInt(vmP, valueP->u.sint); break;
+        case CFFI_K_TYPE_UINT: dcArgInt(vmP, valueP->u.uint); break;
+        case CFFI_K_TYPE_LONG: dcArgLong(vmP, valueP->u.slong); break;
+        case CFFI_K_TYPE_ULONG: dcArgLong(vmP, valueP->u.ulong); break;
+        case CFFI_K_TYPE_LONGLONG: dcArgLongLong(vmP, valueP->u.slonglong); break;
+        case CFFI_K_TYPE_ULONGLONG: dcArgLongLong(vmP, valueP->u.ulonglong); break;
+        case CFFI_K_TYPE_FLOAT: dcArgFloat(vmP, valueP->u.flt); break;
+        case CFFI_K_TYPE_DOUBLE: dcArgDouble(vmP, valueP->u.dbl); break;
+        case CFFI_K_TYPE_POINTER: dcArgPointer(vmP, valueP->u.ptr); break;
+        default:
+            CFFI_PANIC("UNEXPECTED BASE TYPE");
+            break;
+        }
+    }
+
+#define CALL_(fld_, cffifn_, dcfn_) asyncP->retValue.u.fld_ = dcfn_(vmP, fnAddr)
+#define CALLVOID_() dcCallVoid(vmP, fnAddr)
+#endif
+
+    switch (protoP->returnType.typeAttrs.dataType.baseType) {
+    case CFFI_K_TYPE_VOID: CALLVOID_(); break;
+    case CFFI_K_TYPE_SCHAR: CALL_(schar, CffiCallSCharFunc, dcCallChar); break;
+    case CFFI_K_TYPE_UCHAR: CALL_(uchar, CffiCallUCharFunc, dcCallChar); break;
+    case CFFI_K_TYPE_SHORT: CALL_(sshort, CffiCallShortFunc, dcCallShort); break;
+    case CFFI_K_TYPE_USHORT: CALL_(ushort, CffiCallUShortFunc, dcCallShort); break;
+    case CFFI_K_TYPE_INT: CALL_(sint, CffiCallIntFunc, dcCallInt); break;
+    case CFFI_K_TYPE_UINT: CALL_(uint, CffiCallUIntFunc, dcCallInt); break;
+    case CFFI_K_TYPE_LONG: CALL_(slong, CffiCallLongFunc, dcCallLong); break;
+    case CFFI_K_TYPE_ULONG: CALL_(ulong, CffiCallULongFunc, dcCallLong); break;
+    case CFFI_K_TYPE_LONGLONG:
+        CALL_(slonglong, CffiCallLongLongFunc, dcCallLongLong);
+        break;
+    case CFFI_K_TYPE_ULONGLONG:
+        CALL_(ulonglong, CffiCallULongLongFunc, dcCallLongLong);
+        break;
+    case CFFI_K_TYPE_FLOAT: CALL_(flt, CffiCallFloatFunc, dcCallFloat); break;
+    case CFFI_K_TYPE_DOUBLE: CALL_(dbl, CffiCallDoubleFunc, dcCallDouble); break;
+    default:
+        CFFI_PANIC("UNEXPECTED BASE TYPE");
+        break;
+    }
+#undef CALL_
+#undef CALLVOID_
+}
+
+/* Function: CffiAsyncResultToObj
+ * Wraps the return value of a completed asynchronous call.
+ *
+ * Parameters:
+ * asyncP - completed call
+ * resultObjP - location to store the wrapped value
+ *
+ * The value is converted as for synchronous calls so any annotations on
+ * the return type are honored. Must be called from the interpreter thread.
+ *
+ * Returns:
+ * *TCL_OK* on success with a Tcl_Obj with reference count 0 stored in
+ * *resultObjP*, *TCL_ERROR* on failure with error message in the
+ * interpreter.
+ */
+static CffiResult
+CffiAsyncResultToObj(CffiAsyncCall *asyncP, Tcl_Obj **resultObjP)
+{
+    return CffiNativeScalarToObj(asyncP->ipCtxP,
+                                 &asyncP->fnP->protoP->returnType.typeAttrs,
+                                 &asyncP->retValue.u,
+                                 0,
+                                 resultObjP);
+}
+
+/* Function: CffiAsyncEventProc
+ * Delivers the result of an asynchronous call in the interpreter thread.
+ *
+ * Parameters:
+ * evP - the event queued by the worker thread
+ * flags - event flags passed to Tcl_ServiceEvent
+ *
+ * Returns:
+ * 1 if the event was processed, 0 otherwise.
+ */
+static int
+CffiAsyncEventProc(Tcl_Event *evP, int flags)
+{
+    CffiAsyncCall *asyncP = ((CffiAsyncEvent *)evP)->asyncP;
+    Tcl_Interp *ip        = asyncP->ipCtxP->interp;
+    Tcl_Obj *evalObj;
+    Tcl_Obj *resultObj;
+    CffiResult ret;
+
+    if (!(flags & TCL_FILE_EVENTS))
+        return 0;
+
+    ret = CffiAsyncResultToObj(asyncP, &resultObj);
+    if (ret != TCL_OK)
+        resultObj = Tcl_GetObjResult(ip);
+    evalObj = Tcl_DuplicateObj(asyncP->cmdObj);
+    Tcl_IncrRefCount(evalObj);
+    Tcl_ListObjAppendElement(NULL, evalObj, Tcl_NewIntObj(ret));
+    Tcl_ListObjAppendElement(NULL, evalObj, resultObj);
+
+    /* Note the interpreter, and ipCtxP, may be deleted by the callback */
+    Tcl_Preserve(ip);
+    ret = Tcl_EvalObjEx(ip, evalObj, TCL_EVAL_GLOBAL);
+    if (ret != TCL_OK)
+        Tcl_BackgroundException(ip, ret);
+    Tcl_Release(ip);
+
+    Tcl_DecrRefCount(evalObj);
+    CffiAsyncCallFree(asyncP);
+    return 1;
+}
+
+/* Function: CffiAsyncEventDeleteProc
+ * Tcl_DeleteEvents callback to discard undelivered results on
+ * interpreter deletion.
+ *
+ * Parameters:
+ * evP - a queued event
+ * cdata - interpreter context being deleted
+ *
+ * Returns:
+ * 1 if the event is to be deleted, 0 otherwise.
+ */
+static int
+CffiAsyncEventDeleteProc(Tcl_Event *evP, ClientData cdata)
+{
+    CffiAsyncCall *asyncP;
+
+    /* Note Tcl sets proc to NULL for an event being serviced. */
+    if (evP->proc != CffiAsyncEventProc)
+        return 0;
+    asyncP = ((CffiAsyncEvent *)evP)->asyncP;
+    if (asyncP->ipCtxP != (CffiInterpCtx *)cdata)
+        return 0;
+    CffiAsyncCallFree(asyncP);
+    return 1;
+}
+
+/* Function: CffiAsyncWorker
+ * Worker thread main loop.
+ *
+ * Parameters:
+ * cdata - unused
+ *
+ * Workers block waiting for calls when idle. They exit when
+ * <CffiAsyncExitHandler> sets the shutdown flag at process exit.
+ */
+static Tcl_ThreadCreateType
+CffiAsyncWorker(ClientData cdata)
+{
+    CffiAsyncCall *asyncP;
+    CffiAsyncEvent *evP;
+#ifdef CFFI_USE_DYNCALL
+    DCCallVM *vmP = dcNewCallVM(4096); /* Same as interpreter's */
+#endif
+
+    Tcl_MutexLock(&cffiAsyncMutex);
+    while (1) {
+        while (cffiAsyncQueueHeadP == NULL && !cffiAsyncShutdown) {
+            cffiAsyncNumIdle += 1;
+            Tcl_ConditionWait(&cffiAsyncQueueCond, &cffiAsyncMutex, NULL);
+            cffiAsyncNumIdle -= 1;
+        }
+        if (cffiAsyncShutdown)
+            break;
+        asyncP              = cffiAsyncQueueHeadP;
+        cffiAsyncQueueHeadP = asyncP->nextP;
+        if (cffiAsyncQueueHeadP == NULL)
+            cffiAsyncQueueTailP = NULL;
+        Tcl_MutexUnlock(&cffiAsyncMutex);
+
+#ifdef CFFI_USE_LIBFFI
+        CffiAsyncInvoke(asyncP);
+#endif
+#ifdef CFFI_USE_DYNCALL
+        CffiAsyncInvoke(asyncP, vmP);
+#endif
+
+        evP                = ckalloc(sizeof(*evP));
+        evP->header.proc   = CffiAsyncEventProc;
+        evP->header.nextPtr = NULL;
+        evP->asyncP        = asyncP;
+
+        /*
+         * Queue the event and mark completion under the mutex so that
+         * CffiAsyncFinit, once the pending count drops to 0, can rely on
+         * all events for the interpreter being in its event queue.
+         */
+        Tcl_MutexLock(&cffiAsyncMutex);
+        Tcl_ThreadQueueEvent(asyncP->threadId, &evP->header, TCL_QUEUE_TAIL);
+        Tcl_ThreadAlert(asyncP->threadId);
+        asyncP->ipCtxP->nAsyncCalls -= 1;
+        Tcl_ConditionNotify(&asyncP->ipCtxP->asyncCond);
+    }
+    Tcl_MutexUnlock(&cffiAsyncMutex);
+#ifdef CFFI_USE_DYNCALL
+    dcFree(vmP);
+#endif
+    Tcl_ExitThread(0);
+    TCL_THREAD_CREATE_RETURN;
+}
+
+/* Function: CffiAsyncExitHandler
+ * Terminates the worker threads at process exit.
+ *
+ * Parameters:
+ * cdata - unused
+ *
+ * Calls still queued are abandoned. Workers executing a call cannot be
+ * interrupted so the function waits for the call to complete.
+ */
+static void
+CffiAsyncExitHandler(ClientData cdata)
+{
+    int i, numWorkers;
+    int result;
+
+    Tcl_MutexLock(&cffiAsyncMutex);
+    cffiAsyncShutdown = 1;
+    numWorkers        = cffiAsyncNumWorkers;
+    Tcl_ConditionNotify(&cffiAsyncQueueCond);
+    Tcl_MutexUnlock(&cffiAsyncMutex);
+
+    for (i = 0; i < numWorkers; ++i)
+        Tcl_JoinThread(cffiAsyncWorkerIds[i], &result);
+
+    Tcl_MutexLock(&cffiAsyncMutex);
+    cffiAsyncNumWorkers = 0;
+    cffiAsyncNumIdle    = 0;
+    Tcl_MutexUnlock(&cffiAsyncMutex);
+    Tcl_ConditionFinalize(&cffiAsyncQueueCond);
+}
+
+/* Function: CffiAsyncSubmit
+ * Queues a call to the worker pool, creating a worker if necessary.
+ *
+ * Parameters:
+ * asyncP - call to queue
+ *
+ * Returns:
+ * Returns TCL_OK on success and TCL_ERROR on failure with error message
+ * in the interpreter.
+ */
+static CffiResult
+CffiAsyncSubmit(CffiAsyncCall *asyncP)
+{
+    CffiInterpCtx *ipCtxP = asyncP->ipCtxP;
+    CffiResult ret        = TCL_OK;
+
+    Tcl_MutexLock(&cffiAsyncMutex);
+    if (cffiAsyncShutdown) {
+        ret = Tclh_ErrorOperFailed(
+            ipCtxP->interp, "queue", NULL, "Process is exiting.");
+    }
+    else if (cffiAsyncNumIdle == 0
+             && cffiAsyncNumWorkers < CFFI_K_ASYNC_MAX_WORKERS) {
+        Tcl_ThreadId tid;
+        if (Tcl_CreateThread(&tid,
+                             CffiAsyncWorker,
+                             NULL,
+                             TCL_THREAD_STACK_DEFAULT,
+                             TCL_THREAD_JOINABLE)
+            == TCL_OK) {
+            /* Workers are joined at exit. Register on first creation. */
+            if (cffiAsyncNumWorkers == 0)
+                Tcl_CreateExitHandler(CffiAsyncExitHandler, NULL);
+            cffiAsyncWorkerIds[cffiAsyncNumWorkers++] = tid;
+        }
+        else if (cffiAsyncNumWorkers == 0) {
+            ret = Tclh_ErrorOperFailed(
+                ipCtxP->interp, "create", NULL, "Could not create worker thread.");
+        }
+    }
+    if (ret == TCL_OK) {
+        asyncP->nextP = NULL;
+        if (cffiAsyncQueueTailP)
+            cffiAsyncQueueTailP->nextP = asyncP;
+        else
+            cffiAsyncQueueHeadP = asyncP;
+        cffiAsyncQueueTailP = asyncP;
+        ipCtxP->nAsyncCalls += 1;
+        Tcl_ConditionNotify(&cffiAsyncQueueCond);
+    }
+    Tcl_MutexUnlock(&cffiAsyncMutex);
+    return ret;
+}
+
+/* Function: CffiAsyncFinit
+ * Cleans up asynchronous calls for an interpreter being deleted.
+ *
+ * Parameters:
+ * ipCtxP - interpreter context
+ *
+ * Calls not yet started are discarded. Calls in progress cannot be
+ * aborted so the function waits for them to complete. Results not yet
+ * delivered are then discarded.
+ */
+void
+CffiAsyncFinit(CffiInterpCtx *ipCtxP)
+{
+    CffiAsyncCall *asyncP;
+    CffiAsyncCall *discardsP = NULL;
+    CffiAsyncCall **prevPP;
+
+    Tcl_MutexLock(&cffiAsyncMutex);
+    prevPP = &cffiAsyncQueueHeadP;
+    cffiAsyncQueueTailP = NULL;
+    while ((asyncP = *prevPP) != NULL) {
+        if (asyncP->ipCtxP == ipCtxP) {
+            *prevPP          = asyncP->nextP;
+            asyncP->nextP    = discardsP;
+            discardsP        = asyncP;
+            ipCtxP->nAsyncCalls -= 1;
+        }
+        else {
+            cffiAsyncQueueTailP = asyncP;
+            prevPP              = &asyncP->nextP;
+        }
+    }
+    while (ipCtxP->nAsyncCalls > 0)
+        Tcl_ConditionWait(&ipCtxP->asyncCond, &cffiAsyncMutex, NULL);
+    Tcl_MutexUnlock(&cffiAsyncMutex);
+    Tcl_ConditionFinalize(&ipCtxP->asyncCond);
+
+    while (discardsP) {
+        asyncP    = discardsP;
+        discardsP = asyncP->nextP;
+        CffiAsyncCallFree(asyncP);
+    }
+    Tcl_DeleteEvents(CffiAsyncEventDeleteProc, ipCtxP);
+}
+
+/* Function: CffiAsyncObjCmd
+ * Implements the *cffi::async* script level command.
+ *
+ * Parameters:
+ * cdata - interpreter context
+ * ip - interpreter
+ * objc - number of elements in *objv*
+ * objv - array containing the command and arguments
+ *
+ * The syntax is
+ *   async CALLBACK FUNCTION ?ARG ...?
+ * where FUNCTION is as accepted by <CffiFunctionFromObj>. The function is
+ * called in a worker thread and on completion, CALLBACK is invoked at the
+ * global level from the event loop with the return code and function
+ * result appended.
+ *
+ * Returns:
+ * Returns TCL_OK on success and TCL_ERROR on failure with error message
+ * in the interpreter.
+ */
+CffiResult
+CffiAsyncObjCmd(ClientData cdata,
+                Tcl_Interp *ip,
+                int objc,
+                Tcl_Obj *const objv[])
+{
+    CffiInterpCtx *ipCtxP = (CffiInterpCtx *)cdata;
+    CffiAsyncCall *asyncP;
+    CffiFunction *fnP;
+    CffiProto *protoP;
+    Tcl_Size cmdLen;
+    int nArgObjs;
+    int i;
+
+    CHECK_NARGS(ip, 3, INT_MAX, "CALLBACK FUNCTION ?ARG ...?");
+    CHECK(Tcl_ListObjLength(ip, objv[1], &cmdLen));
+    if (cmdLen == 0)
+        return Tclh_ErrorInvalidValue(ip, objv[1], "Empty callback.");
+    CHECK(CffiFunctionFromObj(ipCtxP, objv[2], &fnP));
+
+    CffiFunctionRef(fnP);
+    protoP = fnP->protoP;
+    if (!(protoP->planP->flags & CFFI_F_PLAN_SCALAR)
+        || (protoP->returnType.typeAttrs.flags & CFFI_F_ATTR_SAVEERROR)) {
+        CffiFunctionUnref(fnP);
+        return Tclh_ErrorInvalidValue(
+            ip,
+            objv[2],
+            "Function not eligible for asynchronous calls. Parameters "
+            "must be numeric or pointer inputs and the return type void "
+            "or numeric without error annotations.");
+    }
+    nArgObjs = objc - 3;
+    if (nArgObjs < protoP->planP->nMinArgs || nArgObjs > protoP->nParams) {
+        Tcl_Obj *syntaxObj = Tcl_NewListObj(protoP->nParams + 4, NULL);
+        Tcl_ListObjAppendElement(NULL, syntaxObj, Tcl_NewStringObj("Syntax:", -1));
+        for (i = 0; i < 3; ++i)
+            Tcl_ListObjAppendElement(NULL, syntaxObj, objv[i]);
+        for (i = 0; i < protoP->nParams; ++i)
+            Tcl_ListObjAppendElement(NULL, syntaxObj, protoP->params[i].nameObj);
+        Tclh_ErrorGeneric(ip, "NUMARGS", Tcl_GetString(syntaxObj));
+        Tcl_DecrRefCount(syntaxObj);
+        CffiFunctionUnref(fnP);
+        return TCL_ERROR;
+    }
+    if ((uintptr_t)fnP->fnAddr < 0xffff) {
+        CffiFunctionUnref(fnP);
+        return Tclh_ErrorInvalidValue(
+            ip, NULL, "Function pointer not in executable page.");
+    }
+#ifdef CFFI_USE_LIBFFI
+    /* protoP->cifP is lazy-initialized. Must be done in this thread. */
+    if (CffiLibffiInitProtoCif(ipCtxP, protoP) != TCL_OK) {
+        CffiFunctionUnref(fnP);
+        return TCL_ERROR;
+    }
+#endif
+
+    asyncP           = ckalloc(sizeof(*asyncP));
+    asyncP->nextP    = NULL;
+    asyncP->ipCtxP   = ipCtxP;
+    asyncP->threadId = Tcl_GetCurrentThread();
+    asyncP->fnP      = fnP; /* Reference released in CffiAsyncCallFree */
+    asyncP->cmdObj   = objv[1];
+    Tcl_IncrRefCount(asyncP->cmdObj);
+
+    for (i = 0; i < protoP->nParams; ++i) {
+        CffiTypeAndAttrs *typeAttrsP = &protoP->params[i].typeAttrs;
+        CffiResult ret;
+        if (i >= nArgObjs) {
+            /* Eligible functions only have native defaults */
+            CFFI_ASSERT(protoP->planP->args[i].flags
+                        & CFFI_F_ARGPLAN_NATIVEDEFAULT);
+            asyncP->argValues[i] = protoP->planP->args[i].defaultValue;
+            ret                  = TCL_OK;
+        }
+        else if (protoP->planP->args[i].op == CFFI_K_ARGOP_SCALARIN) {
+            /* Numerics do not allocate from the memlifo */
+            ret = CffiNativeScalarFromObj(ipCtxP,
+                                          typeAttrsP,
+                                          objv[3 + i],
+                                          0,
+                                          &asyncP->argValues[i],
+                                          0,
+                                          &ipCtxP->memlifo);
+        }
+        else {
+            CFFI_ASSERT(typeAttrsP->dataType.baseType == CFFI_K_TYPE_POINTER);
+            ret = CffiPointerFromObj(
+                ipCtxP, typeAttrsP, objv[3 + i], &asyncP->argValues[i].u.ptr);
+        }
+        if (ret != TCL_OK) {
+            CffiAsyncCallFree(asyncP);
+            return TCL_ERROR;
+        }
+#ifdef CFFI_USE_LIBFFI
+        asyncP->argValuesP[i] = &asyncP->argValues[i];
+#endif
+    }
+
+    if (CffiAsyncSubmit(asyncP) != TCL_OK) {
+        CffiAsyncCallFree(asyncP);
+        return TCL_ERROR;
+    }
+    return TCL_OK;
+}
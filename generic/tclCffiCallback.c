@@ -102,7 +102,7 @@ CffiCallbackCheckType(CffiInterpCtx *ipCtxP,
     (CFFI_F_ATTR_OUT | CFFI_F_ATTR_INOUT | CFFI_F_ATTR_REQUIREMENT_MASK \
      | (CFFI_F_ATTR_SAFETY_MASK & ~CFFI_F_ATTR_UNSAFE)                  \
      | CFFI_F_ATTR_ERROR_MASK | CFFI_F_ATTR_STOREONERROR                \
-     | CFFI_F_ATTR_STOREALWAYS | CFFI_F_ATTR_STRUCTSIZE)
+     | CFFI_F_ATTR_STOREALWAYS | CFFI_F_ATTR_STRUCTSIZE | CFFI_F_ATTR_OUTDICT)
 
     if (typeAttrsP->flags & CFFI_INVALID_CALLBACK_ATTR_FLAGS) {
         return Tclh_ErrorInvalidValue(
@@ -14,10 +14,7 @@ CffiArgPostProcess(CffiCall *callP, int arg_index, Tcl_Obj **resultObjP);
 static void CffiArgCleanup(CffiCall *callP, int arg_index);
 static CffiResult CffiReturnPrepare(CffiCall *callP);
 static CffiResult CffiReturnCleanup(CffiCall *callP);
-static void CffiPointerArgsDispose(CffiInterpCtx *ipCtxP,
-                                   int nArgs,
-                                   CffiArgument *argsP,
-                                   int callSucceeded);
+static void CffiPointerArgsDispose(CffiCall *callP, int callFailed);
 static CffiResult CffiGetCountFromValue(Tcl_Interp *ip,
                                         CffiBaseType valueType,
                                         const CffiValue *valueP,
@@ -40,59 +37,53 @@ CffiGrabSystemError(const CffiTypeAndAttrs *typeAttrsP,
 }
 
 
-/* Function: CffiPointerArgsDispose
- * Disposes pointer arguments
+/* Function: CffiPointerArgDispose
+ * Disposes a pointer argument if so annotated
  *
  * Parameters:
- * ip - interpreter
- * nArgs - size of argsP[]
- * argsP - array of argument values
+ * ipCtxP - interpreter context
+ * argP - argument value
  * callFailed - 0 if the function invocation had succeeded, else non-0
  *
- * The function loops through all argument values that are pointers
- * and annotated as *dispose* or *disposeonsuccess*. Any such pointers
- * are unregistered.
- *
  * Returns:
  * Nothing.
  */
 static void
-CffiPointerArgsDispose(CffiInterpCtx *ipCtxP,
-                       int nArgs,
-                       CffiArgument *argsP,
-                       int callFailed)
+CffiPointerArgDispose(CffiInterpCtx *ipCtxP, CffiArgument *argP, int callFailed)
 {
     Tcl_Interp *ip = ipCtxP->interp;
-    int i;
-    for (i = 0; i < nArgs; ++i) {
-        CffiTypeAndAttrs *typeAttrsP = argsP[i].typeAttrsP;
-        if (typeAttrsP->dataType.baseType == CFFI_K_TYPE_POINTER
-            && (typeAttrsP->flags & (CFFI_F_ATTR_IN | CFFI_F_ATTR_INOUT))) {
-            /*
-             * DISPOSE - always dispose of pointer
-             * DISPOSEONSUCCESS - dispose if the call had returned successfully
-             */
-            if ((typeAttrsP->flags & CFFI_F_ATTR_DISPOSE)
-                || ((typeAttrsP->flags & CFFI_F_ATTR_DISPOSEONSUCCESS)
-                    && !callFailed)) {
-                int nptrs = argsP[i].arraySize;
-                /* Note no error checks because the CffiFunctionSetup calls
-                   above would have already done validation */
-                if (nptrs < 0) {
-                    /* Scalar */
-                    if (argsP[i].savedValue.u.ptr != NULL)
-                        Tclh_PointerUnregister(
-                            ip, ipCtxP->tclhCtxP, argsP[i].savedValue.u.ptr);
+    CffiTypeAndAttrs *typeAttrsP = argP->typeAttrsP;
+    if (typeAttrsP->dataType.baseType == CFFI_K_TYPE_POINTER
+        && (typeAttrsP->flags & (CFFI_F_ATTR_IN | CFFI_F_ATTR_INOUT))) {
+        /*
+         * DISPOSE - always dispose of pointer
+         * DISPOSEONSUCCESS - dispose if the call had returned successfully
+         */
+        if ((typeAttrsP->flags & CFFI_F_ATTR_DISPOSE)
+            || ((typeAttrsP->flags & CFFI_F_ATTR_DISPOSEONSUCCESS)
+                && !callFailed)) {
+            int nptrs = argP->arraySize;
+            /* Note no error checks because the CffiFunctionSetup calls
+               above would have already done validation */
+            if (nptrs < 0) {
+                /* Scalar */
+                if (argP->savedValue.u.ptr != NULL) {
+                    Tclh_PointerUnregister(
+                        ip, ipCtxP->tclhCtxP, argP->savedValue.u.ptr);
+                    CffiPointerWatchesInvalidate(ipCtxP,
+                                                 argP->savedValue.u.ptr);
                 }
-                else {
-                    /* Array */
-                    int j;
-                    void **ptrArray = argsP[i].savedValue.u.ptr;
-                    CFFI_ASSERT(ptrArray);
-                    for (j = 0; j < nptrs; ++j) {
-                        if (ptrArray[j] != NULL)
-                            Tclh_PointerUnregister(
-                                ip, ipCtxP->tclhCtxP, ptrArray[j]);
+            }
+            else {
+                /* Array */
+                int j;
+                void **ptrArray = argP->savedValue.u.ptr;
+                CFFI_ASSERT(ptrArray);
+                for (j = 0; j < nptrs; ++j) {
+                    if (ptrArray[j] != NULL) {
+                        Tclh_PointerUnregister(
+                            ip, ipCtxP->tclhCtxP, ptrArray[j]);
+                        CffiPointerWatchesInvalidate(ipCtxP, ptrArray[j]);
                     }
                 }
             }
@@ -100,6 +91,38 @@ CffiPointerArgsDispose(CffiInterpCtx *ipCtxP,
     }
 }
 
+/* Function: CffiPointerArgsDispose
+ * Disposes pointer arguments
+ *
+ * Parameters:
+ * callP - call context
+ * callFailed - 0 if the function invocation had succeeded, else non-0
+ *
+ * The function loops through all argument values that are pointers
+ * and annotated as *dispose* or *disposeonsuccess*. Any such pointers
+ * are unregistered. The fixed parameters to be checked are taken from
+ * the prototype's call plan. Varargs arguments are checked individually.
+ *
+ * Returns:
+ * Nothing.
+ */
+static void
+CffiPointerArgsDispose(CffiCall *callP, int callFailed)
+{
+    CffiInterpCtx *ipCtxP = callP->fnP->ipCtxP;
+    CffiProto *protoP     = callP->fnP->protoP;
+    CffiCallPlan *planP   = protoP->planP;
+    int i;
+
+    for (i = 0; i < planP->nDisposables; ++i) {
+        CffiPointerArgDispose(
+            ipCtxP, &callP->argsP[planP->disposeIndices[i]], callFailed);
+    }
+    for (i = protoP->nParams; i < callP->nArgs; ++i) {
+        CffiPointerArgDispose(ipCtxP, &callP->argsP[i], callFailed);
+    }
+}
+
 /* Function: CffiArgPrepareChars
  * Initializes a CffiValue to pass a chars argument.
  *
@@ -355,6 +378,84 @@ CffiNullifyEmptyArrayInParam(Tcl_Interp *ip, int attrFlags, void **arrayAddressP
     return TCL_OK;
 }
 
+/* Function: CffiArgPrepareScalarIn
+ * Prepares a numeric scalar input argument passed by value.
+ *
+ * Parameters:
+ * callP - function call context
+ * arg_index - the index of the argument. The *typeAttrsP* field of the
+ *   slot must have been initialized and the flags field should be 0.
+ * valueObj - the Tcl_Obj containing the value
+ *
+ * This is the CFFI_K_ARGOP_SCALARIN operation of a call plan and is
+ * equivalent to, but much cheaper than, the corresponding path through
+ * <CffiArgPrepare> which must first dispatch on type and attributes.
+ *
+ * Returns:
+ * Returns TCL_OK on success and TCL_ERROR on failure with error message
+ * in the interpreter.
+ */
+static CffiResult
+CffiArgPrepareScalarIn(CffiCall *callP, int arg_index, Tcl_Obj *valueObj)
+{
+    CffiInterpCtx *ipCtxP = callP->fnP->ipCtxP;
+    CffiArgument *argP    = &callP->argsP[arg_index];
+
+    CFFI_ASSERT(argP->flags == 0);
+    CFFI_ASSERT(valueObj);
+
+    argP->varNameObj = NULL;
+    /* NOTE - &argP->value is start of all field values */
+    CHECK(CffiNativeScalarFromObj(ipCtxP,
+                                  argP->typeAttrsP,
+                                  valueObj,
+                                  0,
+                                  &argP->value,
+                                  0,
+                                  &ipCtxP->memlifo));
+    argP->flags |= CFFI_F_ARG_INITIALIZED;
+#ifdef CFFI_USE_LIBFFI
+    callP->argValuesPP[arg_index] = &argP->value;
+#endif
+#ifdef CFFI_USE_DYNCALL
+    if (!callP->deferLoad)
+        CffiReloadArg(callP, argP, argP->typeAttrsP);
+#endif
+    return TCL_OK;
+}
+
+/* Function: CffiArgPrepareScalarDefault
+ * Prepares a numeric scalar input argument from its native default.
+ *
+ * Parameters:
+ * callP - function call context
+ * arg_index - the index of the argument. The *typeAttrsP* field of the
+ *   slot must have been initialized and the flags field should be 0.
+ *
+ * The call plan entry for the argument must have the
+ * CFFI_F_ARGPLAN_NATIVEDEFAULT flag set.
+ */
+static void
+CffiArgPrepareScalarDefault(CffiCall *callP, int arg_index)
+{
+    CffiArgument *argP = &callP->argsP[arg_index];
+    const CffiArgPlan *argPlanP = &callP->fnP->protoP->planP->args[arg_index];
+
+    CFFI_ASSERT(argP->flags == 0);
+    CFFI_ASSERT(argPlanP->flags & CFFI_F_ARGPLAN_NATIVEDEFAULT);
+
+    argP->varNameObj = NULL;
+    argP->value      = argPlanP->defaultValue;
+    argP->flags |= CFFI_F_ARG_INITIALIZED;
+#ifdef CFFI_USE_LIBFFI
+    callP->argValuesPP[arg_index] = &argP->value;
+#endif
+#ifdef CFFI_USE_DYNCALL
+    if (!callP->deferLoad)
+        CffiReloadArg(callP, argP, argP->typeAttrsP);
+#endif
+}
+
 /* Function: CffiArgPrepare
  * Prepares a argument for a DCCall
  *
@@ -454,6 +555,10 @@ CffiArgPrepare(CffiCall *callP, int arg_index, Tcl_Obj *valueObj)
      * CFFI_F_ATTR_RETVAL flag is set, the value returned in the parameter
      * by the function is forwarded up as the function return so there
      * is not variable name supplied and valueObj will be NULL.
+     *
+     * Similarly, if the function return type has the CFFI_F_ATTR_OUTDICT
+     * flag set, output values are returned in a dictionary. valueObj is
+     * then NULL for out parameters and the value itself for inout.
      */
     *varNameObjP = NULL;
     if (flags & (CFFI_F_ATTR_OUT | CFFI_F_ATTR_INOUT)) {
@@ -462,6 +567,10 @@ CffiArgPrepare(CffiCall *callP, int arg_index, Tcl_Obj *valueObj)
             CFFI_ASSERT(flags & CFFI_F_ATTR_OUT);
             CFFI_ASSERT(valueObj == NULL);
         }
+        else if (callP->fnP->protoP->returnType.typeAttrs.flags
+                 & CFFI_F_ATTR_OUTDICT) {
+            CFFI_ASSERT((flags & CFFI_F_ATTR_INOUT) || valueObj == NULL);
+        }
         else {
             /* valueObj holds the name of a variable */
             if (flags & CFFI_F_ATTR_NULLIFEMPTY) {
@@ -728,9 +837,10 @@ CffiArgPrepare(CffiCall *callP, int arg_index, Tcl_Obj *valueObj)
                                               typeAttrsP->dataType.u.structP));
                 }
                 CFFI_ASSERT(typeAttrsP->dataType.u.structP->dcAggrP);
-                dcArgAggr(callP->fnP->ipCtxP->vmP,
-                          typeAttrsP->dataType.u.structP->dcAggrP,
-                          structValueP);
+                if (!callP->deferLoad)
+                    dcArgAggr(callP->fnP->ipCtxP->vmP,
+                              typeAttrsP->dataType.u.structP->dcAggrP,
+                              structValueP);
                 argP->value.u.ptr = structValueP;
 # endif
 # ifdef CFFI_USE_LIBFFI
@@ -968,9 +1078,10 @@ pass_null_array:
  *
  * Post processing of the argument consists of checking if the parameter
  * was an *out* or *inout* parameter and storing it in the output Tcl variable
- * named by the varNameObj field of the argument descriptor if it is not
- * NULL. If it is NULL, as is the case with the CFFI_F_ATTR_RETVAL attribute
- * set, it is returned in the location pointed by resultObjP. Note the
+ * named by the varNameObj field of the argument descriptor. If resultObjP
+ * is not NULL, as is the case for parameters with the CFFI_F_ATTR_RETVAL
+ * attribute or functions returning outputs as a dictionary, the value is
+ * instead returned in the location pointed by resultObjP. Note the
  * reference count of the returned Tcl_Obj is not incremented before returning.
  *
  * Note no cleanup of argument storage is done.
@@ -981,7 +1092,7 @@ pass_null_array:
  * Parameters:
  * callP - the call context
  * arg_index - index of argument to do post processing
- * resultObjP - location to store result if the varNameObj field is NULL.
+ * resultObjP - location to store result instead of the variable. May be NULL.
  *
  * Returns:
  * *TCL_OK* on success,
@@ -1186,8 +1297,7 @@ CffiArgPostProcess(CffiCall *callP, int arg_index, Tcl_Obj **resultObjP)
 store_value:
     CFFI_ASSERT(valueObj);
 
-    if (typeAttrsP->flags & CFFI_F_ATTR_RETVAL) {
-        CFFI_ASSERT(resultObjP);
+    if (resultObjP) {
         *resultObjP = valueObj;
     }
     else {
@@ -1352,6 +1462,7 @@ void CffiFunctionCleanup(CffiFunction *fnP)
         CffiProtoUnref(fnP->protoP);
     if (fnP->cmdNameObj)
         Tcl_DecrRefCount(fnP->cmdNameObj);
+    CffiStatsFree(fnP);
 }
 
 /* Function: CffiDefaultErrorHandler
@@ -1584,7 +1695,11 @@ CffiGetCountFromValue(Tcl_Interp *ip,
  *   will be NULL.
  * varArgTypesP - array of type descriptors for the varargs arguments
  *   May be NULL if no varargs.
- * The function resets the call context and sets up the arguments.
+ *
+ * The fixed arguments are prepared in the order given by the call plan
+ * so that parameters holding counts for dynamically sized arrays are
+ * always prepared before the arrays themselves. Arguments are therefore
+ * set up in a single pass.
  *
  * As part of setting up the call stack, the function may allocate memory
  * from the context memlifo. Caller responsible for freeing.
@@ -1600,13 +1715,15 @@ CffiFunctionSetupArgs(CffiCall *callP,
                       CffiTypeAndAttrs *varArgTypesP)
 {
     int i;
-    int need_pass2;
+    int k;
     CffiArgument *argsP;
     CffiProto *protoP;
+    CffiCallPlan *planP;
     Tcl_Interp *ip;
     CffiInterpCtx *ipCtxP;
 
     protoP = callP->fnP->protoP;
+    planP  = protoP->planP;
     ipCtxP = callP->fnP->ipCtxP;
     ip     = ipCtxP->interp;
 
@@ -1632,38 +1749,75 @@ CffiFunctionSetupArgs(CffiCall *callP,
     callP->argValuesPP = (void **)Tclh_LifoAlloc(
         &ipCtxP->memlifo, callP->nArgs * sizeof(void *));
 #endif
-
+#ifdef CFFI_USE_DYNCALL
     /*
-     * Arguments are set up in two phases - first set up those arguments that
-     * are not dependent on other argument values. Then loop again to set up
-     * the latter. Currently only dynamically sized arrays are dependent on
-     * other arguments.
+     * dyncall arguments must be pushed in parameter order. If preparation
+     * is in a different order, push them all at the end.
      */
-    need_pass2 = 0;
-    for (i = 0; i < callP->nArgs; ++i) {
+    callP->deferLoad = (planP->flags & CFFI_F_PLAN_REORDERED) != 0;
+#endif
+
+    for (k = 0; k < callP->nArgs; ++k) {
         CffiTypeAndAttrs *typeAttrsP;
 
-        if (i < protoP->nParams) {
-            /* Fixed param */
+        if (k < protoP->nParams) {
+            /* Fixed param. Dispatch on the op compiled into the call plan */
+            i          = planP->prepareOrder[k];
             typeAttrsP = &protoP->params[i].typeAttrs;
+            if (planP->args[i].op == CFFI_K_ARGOP_SCALARIN) {
+                argsP[i].typeAttrsP = typeAttrsP;
+                argsP[i].arraySize  = -1;
+                /* Defaulted arguments are passed as the default object */
+                if (argObjs[i] == typeAttrsP->parseModeSpecificObj
+                    && (planP->args[i].flags & CFFI_F_ARGPLAN_NATIVEDEFAULT)) {
+                    CffiArgPrepareScalarDefault(callP, i);
+                }
+                else if (CffiArgPrepareScalarIn(callP, i, argObjs[i])
+                         != TCL_OK)
+                    goto cleanup_and_error;
+                continue;
+            }
+            if (CffiTypeIsVLA(&typeAttrsP->dataType)) {
+                /* Dynamic array. The count was prepared earlier in order. */
+                int countIndex = protoP->params[i].arraySizeParamIndex;
+                int actualCount;
+                CFFI_ASSERT(countIndex >= 0 && countIndex < protoP->nParams);
+                CFFI_ASSERT(argsP[countIndex].flags & CFFI_F_ARG_INITIALIZED);
+                if (CffiGetCountFromValue(
+                        ip,
+                        protoP->params[countIndex]
+                            .typeAttrs.dataType.baseType,
+                        &argsP[countIndex].value,
+                        &actualCount)
+                    != TCL_OK)
+                    goto cleanup_and_error;
+                argsP[i].typeAttrsP = typeAttrsP;
+                argsP[i].arraySize  = actualCount;
+                if (CffiArgPrepare(callP, i, argObjs[i]) != TCL_OK)
+                    goto cleanup_and_error;
+                continue;
+            }
         }
         else {
             /* Vararg. */
+            i = k;
             CFFI_ASSERT(varArgTypesP);
 #if defined(CFFI_USE_DYNCALL)
             /* Need to switch modes for varargs params */
-            if (i == protoP->nParams) {
+            if (i == protoP->nParams && !callP->deferLoad) {
                 dcMode(callP->fnP->ipCtxP->vmP, DC_CALL_C_ELLIPSIS_VARARGS);
             }
 #endif
             typeAttrsP = &varArgTypesP[i - protoP->nParams];
+            if (CffiTypeIsVLA(&typeAttrsP->dataType)) {
+                Tclh_ErrorWrongType(ip,
+                                    NULL,
+                                    "Dynamically sized arrays not permitted "
+                                    "for varargs arguments.");
+                goto cleanup_and_error;
+            }
         }
 
-        if (CffiTypeIsVLA(&typeAttrsP->dataType)) {
-            /* Dynamic array. */
-            need_pass2 = 1;
-            continue;
-        }
         argsP[i].typeAttrsP = typeAttrsP;
 
         /* Scalar or fixed size array. Type decl should have ensured size!=0 */
@@ -1672,72 +1826,17 @@ CffiFunctionSetupArgs(CffiCall *callP,
             goto cleanup_and_error;
     }
 
-    if (need_pass2 == 0)
-        return TCL_OK;
-
-    /*
-     * Blast it. We need a second pass since some arguments were unresolved.
-     * Need to reset the dyncall arg stack since some arguments may have
-     * already been loaded.
-     */
-    if (CffiResetCall(ip, callP) != TCL_OK)
-        goto cleanup_and_error;
-    if (CffiReturnPrepare(callP) != TCL_OK)
-        goto cleanup_and_error;
-
-    for (i = 0; i < callP->nArgs; ++i) {
-        int dynamicCountIndex;
-        int actualCount;
-        CffiTypeAndAttrs *typeAttrsP;
-        if (i < protoP->nParams) {
-            typeAttrsP = &protoP->params[i].typeAttrs;
-        }
-        else {
-#if defined(CFFI_USE_DYNCALL)
-            /* Need to switch modes for varargs params */
+#ifdef CFFI_USE_DYNCALL
+    if (callP->deferLoad) {
+        for (i = 0; i < callP->nArgs; ++i) {
             if (i == protoP->nParams) {
                 dcMode(callP->fnP->ipCtxP->vmP, DC_CALL_C_ELLIPSIS_VARARGS);
             }
-#endif
-            typeAttrsP = &varArgTypesP[i - protoP->nParams];
-        }
-
-        if (! CffiTypeIsVLA(&typeAttrsP->dataType)) {
-            /* This arg already been parsed successfully. Just load it. */
-            CFFI_ASSERT(argsP[i].flags & CFFI_F_ARG_INITIALIZED);
-            CffiReloadArg(callP, &argsP[i], typeAttrsP);
-            continue;
+            CffiReloadArg(callP, &argsP[i], argsP[i].typeAttrsP);
         }
-        CFFI_ASSERT((argsP[i].flags & CFFI_F_ARG_INITIALIZED) == 0);
-
-        if (i >= protoP->nParams) {
-            Tclh_ErrorWrongType(ip,
-                                NULL,
-                                "Dynamically sized arrays not permitted for "
-                                "varargs arguments.");
-            goto cleanup_and_error;
-        }
-
-        /* Locate the parameter holding the dynamic count */
-        dynamicCountIndex = protoP->params[i].arraySizeParamIndex;
-        CFFI_ASSERT(dynamicCountIndex >= 0
-                    && dynamicCountIndex < protoP->nParams);
-        CFFI_ASSERT(argsP[dynamicCountIndex].flags & CFFI_F_ARG_INITIALIZED);
-
-        if (CffiGetCountFromValue(
-                ip,
-                protoP->params[dynamicCountIndex].typeAttrs.dataType.baseType,
-                &argsP[dynamicCountIndex].value,
-                &actualCount)
-            != TCL_OK)
-            goto cleanup_and_error;
-
-
-        argsP[i].typeAttrsP = typeAttrsP;
-        argsP[i].arraySize = (int) actualCount;
-        if (CffiArgPrepare(callP, i, argObjs[i]) != TCL_OK)
-            goto cleanup_and_error;
+        callP->deferLoad = 0;
     }
+#endif
 
     return TCL_OK;
 
@@ -1750,6 +1849,204 @@ CffiFunctionSetupArgs(CffiCall *callP,
         return TCL_ERROR;
 }
 
+/*
+ * Saves errno (and GetLastError on Windows) if the function is annotated
+ * with saveerrors. Must be invoked immediately after the function call.
+ */
+#ifdef _WIN32
+#define SAVEERROR()                                                       \
+    do {                                                                  \
+        if (protoP->returnType.typeAttrs.flags & CFFI_F_ATTR_SAVEERROR) { \
+            ipCtxP->savedWinError = GetLastError();                       \
+            ipCtxP->savedErrno    = errno;                                \
+        }                                                                 \
+    } while (0)
+#else
+#define SAVEERROR()                                                       \
+    do {                                                                  \
+        if (protoP->returnType.typeAttrs.flags & CFFI_F_ATTR_SAVEERROR) { \
+            ipCtxP->savedErrno = errno;                                   \
+        }                                                                 \
+    } while (0)
+#endif
+
+/* Function: CffiFunctionCallScalar
+ * Calls a function whose call plan is marked as CFFI_F_PLAN_SCALAR.
+ *
+ * Parameters:
+ * fnP - function to call
+ * ip - interpreter
+ * nArgObjs - number of elements in *objv*. Parameters beyond these are
+ *   filled in from their native defaults.
+ * objv - argument values
+ * startTime - <CffiStatsClock> value at the start of the call if
+ *   statistics are being collected and 0 otherwise
+ *
+ * The prototype for such functions only has numeric and pointer input
+ * parameters passed by value and a void or numeric return type without
+ * any error checking annotations. No output arguments, pointer disposal,
+ * error handlers or variable sized storage need to be dealt with, so the
+ * argument descriptors live on the C stack and the memlifo is not touched.
+ *
+ * Returns:
+ * Returns TCL_OK on success and TCL_ERROR on failure with error message
+ * in the interpreter.
+ */
+static CffiResult
+CffiFunctionCallScalar(CffiFunction *fnP,
+                       Tcl_Interp *ip,
+                       int nArgObjs,
+                       Tcl_Obj *const objv[],
+                       Tcl_WideUInt startTime)
+{
+    CffiProto *protoP     = fnP->protoP;
+    CffiInterpCtx *ipCtxP = fnP->ipCtxP;
+    CffiArgument args[CFFI_K_MAX_SCALAR_PARAMS];
+#ifdef CFFI_USE_LIBFFI
+    void *argValues[CFFI_K_MAX_SCALAR_PARAMS];
+#endif
+    Tcl_Obj *resultObj = NULL;
+    CffiCall callCtx;
+    CffiResult ret = TCL_OK;
+    Tcl_WideUInt nativeTime = 0;
+    int i;
+
+    CFFI_ASSERT(protoP->planP->flags & CFFI_F_PLAN_SCALAR);
+    CFFI_ASSERT(protoP->nParams <= CFFI_K_MAX_SCALAR_PARAMS);
+
+#ifdef CFFI_USE_LIBFFI
+    /* protoP->cifP is lazy-initialized */
+    CHECK(CffiLibffiInitProtoCif(ipCtxP, protoP));
+#endif
+
+    CffiFunctionRef(fnP); /* So it cannot get deallocated in callbacks */
+
+    callCtx.fnP   = fnP;
+    callCtx.nArgs = protoP->nParams;
+    callCtx.argsP = args;
+#ifdef CFFI_USE_LIBFFI
+    callCtx.cifP        = protoP->cifP;
+    callCtx.argValuesPP = argValues;
+    callCtx.retValueP   = NULL;
+#endif
+
+    for (i = 0; i < protoP->nParams; ++i)
+        args[i].flags = 0; /* Mark as uninitialized for cleanup */
+
+    if (CffiResetCall(ip, &callCtx) != TCL_OK
+        || CffiReturnPrepare(&callCtx) != TCL_OK) {
+        ret = TCL_ERROR;
+        goto vamoose;
+    }
+
+    for (i = 0; i < protoP->nParams; ++i) {
+        CffiArgument *argP = &args[i];
+        argP->typeAttrsP   = &protoP->params[i].typeAttrs;
+        argP->arraySize    = -1;
+        if (i >= nArgObjs) {
+            CffiArgPrepareScalarDefault(&callCtx, i);
+            continue;
+        }
+        if (protoP->planP->args[i].op == CFFI_K_ARGOP_SCALARIN) {
+            ret = CffiArgPrepareScalarIn(&callCtx, i, objv[i]);
+        }
+        else {
+            CFFI_ASSERT(argP->typeAttrsP->dataType.baseType
+                        == CFFI_K_TYPE_POINTER);
+            argP->varNameObj = NULL;
+            ret              = CffiPointerFromObj(
+                ipCtxP, argP->typeAttrsP, objv[i], &argP->value.u.ptr);
+            if (ret == TCL_OK) {
+                argP->flags |= CFFI_F_ARG_INITIALIZED;
+#ifdef CFFI_USE_LIBFFI
+                argValues[i] = &argP->value.u.ptr;
+#endif
+#ifdef CFFI_USE_DYNCALL
+                CffiReloadArg(&callCtx, argP, argP->typeAttrsP);
+#endif
+            }
+        }
+        if (ret != TCL_OK)
+            goto vamoose;
+    }
+
+#define CALLSCALARFN(objfn_, dcfn_, type_)   \
+    do {                                     \
+        type_ cretval = dcfn_(&callCtx);     \
+        SAVEERROR();                         \
+        resultObj = objfn_(cretval);         \
+    } while (0)
+
+    if (startTime)
+        nativeTime = CffiStatsClock();
+    switch (protoP->returnType.typeAttrs.dataType.baseType) {
+    case CFFI_K_TYPE_VOID:
+        CffiCallVoidFunc(&callCtx);
+        SAVEERROR();
+        resultObj = Tcl_NewObj();
+        break;
+    case CFFI_K_TYPE_SCHAR:
+        CALLSCALARFN(Tcl_NewIntObj, CffiCallSCharFunc, signed char);
+        break;
+    case CFFI_K_TYPE_UCHAR:
+        CALLSCALARFN(Tcl_NewIntObj, CffiCallUCharFunc, unsigned char);
+        break;
+    case CFFI_K_TYPE_SHORT:
+        CALLSCALARFN(Tcl_NewIntObj, CffiCallShortFunc, short);
+        break;
+    case CFFI_K_TYPE_USHORT:
+        CALLSCALARFN(Tcl_NewIntObj, CffiCallUShortFunc, unsigned short);
+        break;
+    case CFFI_K_TYPE_INT:
+        CALLSCALARFN(Tcl_NewIntObj, CffiCallIntFunc, int);
+        break;
+    case CFFI_K_TYPE_UINT:
+        CALLSCALARFN(Tcl_NewWideIntObj, CffiCallUIntFunc, unsigned int);
+        break;
+    case CFFI_K_TYPE_LONG:
+        CALLSCALARFN(Tcl_NewLongObj, CffiCallLongFunc, long);
+        break;
+    case CFFI_K_TYPE_ULONG:
+        CALLSCALARFN(Tclh_ObjFromULong, CffiCallULongFunc, unsigned long);
+        break;
+    case CFFI_K_TYPE_LONGLONG:
+        CALLSCALARFN(Tcl_NewWideIntObj, CffiCallLongLongFunc, long long);
+        break;
+    case CFFI_K_TYPE_ULONGLONG:
+        CALLSCALARFN(
+            Tclh_ObjFromULongLong, CffiCallULongLongFunc, unsigned long long);
+        break;
+    case CFFI_K_TYPE_FLOAT:
+        CALLSCALARFN(Tcl_NewDoubleObj, CffiCallFloatFunc, float);
+        break;
+    case CFFI_K_TYPE_DOUBLE:
+        CALLSCALARFN(Tcl_NewDoubleObj, CffiCallDoubleFunc, double);
+        break;
+    default:
+        /* Plan compilation should not have marked the prototype */
+        CFFI_PANIC("UNEXPECTED BASE TYPE");
+        break;
+    }
+#undef CALLSCALARFN
+    if (startTime)
+        nativeTime = CffiStatsClock() - nativeTime;
+
+    if (protoP->returnType.typeAttrs.flags & CFFI_F_ATTR_DISCARD)
+        Tcl_DecrRefCount(resultObj);
+    else
+        Tcl_SetObjResult(ip, resultObj);
+
+vamoose:
+    for (i = 0; i < protoP->nParams; ++i) {
+        if (args[i].flags & CFFI_F_ARG_INITIALIZED)
+            CffiArgCleanup(&callCtx, i);
+    }
+    if (startTime)
+        CffiStatsRecord(fnP, ret, startTime, nativeTime);
+    CffiFunctionUnref(fnP);
+    return ret;
+}
+
 /*
  * Implements the call to a function. The cdata parameter contains the
  * prototype information about the function to call. The objv[] parameter
@@ -1764,15 +2061,17 @@ CffiFunctionCall(ClientData cdata,
 {
     CffiFunction *fnP     = (CffiFunction *)cdata;
     CffiProto *protoP     = fnP->protoP;
+    CffiCallPlan *planP   = protoP->planP;
     CffiInterpCtx *ipCtxP = fnP->ipCtxP;
     Tcl_Obj *resultObj             = NULL;
+    Tcl_Obj *outDictObj;
     Tcl_Obj **argObjs              = NULL;
     Tcl_Obj *const *varArgObjs     = NULL;
     CffiTypeAndAttrs *varArgTypesP = NULL;
+    CffiVarargsSig *varargsSigP    = NULL;
     int nArgObjs;
     int nVarArgs;
     int nActualArgs;
-    int varArgsInited = 0;
     int discardResult;
     int argResultIndex; /* If >=0, index of output argument as function result */
     int i;
@@ -1782,6 +2081,8 @@ CffiFunctionCall(ClientData cdata,
     CffiResult ret = TCL_OK;
     CffiResult fnCheckRet = TCL_OK; /* Whether function return check passed */
     Tcl_WideInt sysError;  /* Error retrieved from system */
+    Tcl_WideUInt startTime  = 0; /* Only set if collecting statistics */
+    Tcl_WideUInt nativeTime = 0;
 
     CFFI_ASSERT(ip == ipCtxP->interp);
 
@@ -1793,6 +2094,19 @@ CffiFunctionCall(ClientData cdata,
     if ((uintptr_t) fnP->fnAddr < 0xffff)
         return Tclh_ErrorInvalidValue(ip, NULL, "Function pointer not in executable page.");
 
+    if (ipCtxP->collectStats)
+        startTime = CffiStatsClock();
+
+    /*
+     * Functions with only scalar arguments have a cheaper path. Omitted
+     * arguments are filled from native defaults.
+     */
+    if ((planP->flags & CFFI_F_PLAN_SCALAR) && nArgObjs >= planP->nMinArgs
+        && nArgObjs <= protoP->nParams) {
+        return CffiFunctionCallScalar(
+            fnP, ip, nArgObjs, objv + objArgIndex, startTime);
+    }
+
     /* IMPORTANT - mark has to be popped even on errors before returning */
     /* Ditto for deref-ing fnP */
     mark = Tclh_LifoPushMark(&ipCtxP->memlifo);
@@ -1800,62 +2114,45 @@ CffiFunctionCall(ClientData cdata,
 
     discardResult = (protoP->returnType.typeAttrs.flags & CFFI_F_ATTR_DISCARD);
 
-    /* Check number of arguments passed */
+    /*
+     * Check number of arguments passed. The limits are precomputed in the
+     * call plan. Varargs functions differ from fixed arg functions in that
+     * - they do not permit default values for parameters so at least
+     *   that many arguments must be present
+     * - number of arguments may be more than number in prototype
+     * For normal functions, there may be fewer arguments as defaults
+     * may be present. There should never me more args than formal parameters.
+     */
+    if (nArgObjs < planP->nMinArgs)
+        goto numargs_error;
     if (protoP->flags & CFFI_F_PROTO_VARARGS) {
-        /*
-         * Varargs functions differ from fixed arg functions in that
-         * - they do not permit default values for parameters so at least
-         *   that many arguments must be present
-         * - number of arguments may be more than number in prototype
-         */
-        int minNumArgs = protoP->nParams;
-        if (protoP->returnType.typeAttrs.flags & CFFI_F_ATTR_RETVAL)
-            minNumArgs -= 1; /* One parameter is return val */
-        if (nArgObjs < minNumArgs)
-            goto numargs_error; /* More args than params */
-        nVarArgs   = nArgObjs - minNumArgs;
-        varArgObjs = nVarArgs ? (minNumArgs + objArgIndex + objv) : NULL;
+        nVarArgs   = nArgObjs - planP->nMaxArgs;
+        varArgObjs = nVarArgs ? (planP->nMaxArgs + objArgIndex + objv) : NULL;
+        /* Vararg types (and libffi descriptor) are cached by signature */
+        ret = CffiVarargsSigLookup(
+            ipCtxP, protoP, nVarArgs, varArgObjs, &varargsSigP);
+        if (ret != TCL_OK)
+            goto pop_and_go;
+        varArgTypesP = varargsSigP->varArgTypesP;
     }
     else {
-        /*
-         * For normal functions, there may be fewer arguments as defaults
-         * may be present (if not, error is caught when setting up args)
-         * There should never me more args than formal parameters.
-         */
-        int maxNumArgs = protoP->nParams;
-        if (protoP->returnType.typeAttrs.flags & CFFI_F_ATTR_RETVAL)
-            maxNumArgs -= 1; /* One param is the return val */
-        if (nArgObjs > maxNumArgs)
+        if (nArgObjs > planP->nMaxArgs)
             goto numargs_error; /* More args than params */
         nVarArgs   = 0;
         varArgObjs = NULL;
-    }
-    if (nVarArgs) {
-        /* Need room for varargs type descriptors */
-        varArgTypesP = (CffiTypeAndAttrs *)Tclh_LifoAlloc(
-            &ipCtxP->memlifo, nVarArgs * sizeof(CffiTypeAndAttrs));
-    }
-
 #ifdef CFFI_USE_LIBFFI
-    /* protoP->cifP is lazy-initialized */
-    ret = CffiLibffiInitProtoCif(
-        ipCtxP, protoP, nVarArgs, varArgObjs, varArgTypesP);
-    if (ret != TCL_OK)
-        goto pop_and_go;
-#endif
-#ifdef CFFI_USE_DYNCALL
-    if (nVarArgs) {
-        ret =
-            CffiDyncallVarargsInit(ipCtxP, nVarArgs, varArgObjs, varArgTypesP);
+        /* protoP->cifP is lazy-initialized */
+        ret = CffiLibffiInitProtoCif(ipCtxP, protoP);
         if (ret != TCL_OK)
             goto pop_and_go;
-    }
 #endif
+    }
 
     callCtx.fnP = fnP;
     callCtx.nArgs = 0;
     callCtx.argsP = NULL;
 #ifdef CFFI_USE_LIBFFI
+    callCtx.cifP = varargsSigP ? varargsSigP->cifP : protoP->cifP;
     callCtx.argValuesPP = NULL;
     callCtx.retValueP   = NULL;
 #endif
@@ -1890,10 +2187,9 @@ CffiFunctionCall(ClientData cdata,
      * and varargs.
      */
     nActualArgs = nVarArgs + protoP->nParams;
-    argResultIndex = -1;/* Presume function result returned as is */
+    /* Index of param, if any, to be used for function result */
+    argResultIndex = planP->retvalIndex;
     if (protoP->nParams) {
-        int j;
-
         /*
          * Allocate space to hold all arguments.  Number of fixed parameters
          * plus vararg parameters. Note this is NOT same as nArgObjs due ti
@@ -1902,44 +2198,41 @@ CffiFunctionCall(ClientData cdata,
         argObjs = (Tcl_Obj **)Tclh_LifoAlloc(
             &ipCtxP->memlifo, nActualArgs * sizeof(Tcl_Obj *));
 
-        /* First do the fixed arguments */
-        for (i = 0, j = objArgIndex; i < protoP->nParams; ++i, ++j) {
-            if (protoP->params[i].typeAttrs.flags & CFFI_F_ATTR_RETVAL) {
-                /* This is a parameter to use as return value. No argument
-                   is expected from the caller */
-                CFFI_ASSERT(argResultIndex < 0); /* Checked at definition */
-                argObjs[i]     = NULL;
-                argResultIndex = i; /* Index of param to be used for func result */
-                --j; /* Negate loop ++j so same argument used for next param */
+        /*
+         * First do the fixed arguments. The call plan maps each parameter
+         * to its position in objv[]. A parameter to be used as the return
+         * value has no corresponding argument from the caller.
+         */
+        for (i = 0; i < protoP->nParams; ++i) {
+            int j = planP->args[i].objIndex;
+            if (j < 0) {
+                CFFI_ASSERT(planP->args[i].op == CFFI_K_ARGOP_RETVAL
+                            || (protoP->returnType.typeAttrs.flags
+                                & CFFI_F_ATTR_OUTDICT));
+                argObjs[i] = NULL;
+            }
+            else if (j < nArgObjs) {
+                argObjs[i] = objv[objArgIndex + j];
             }
             else {
-                if (j < objc) {
-                    argObjs[i] = objv[j];
-                }
-                else {
-                    /*
-                     * No argument, must have a default - parseModeSpecificObj
-                     * is used for both defaults and onerror.
-                     */
-                    if ((protoP->params[i].typeAttrs.parseModeSpecificObj
-                         == NULL)
-                        || (protoP->params[i].typeAttrs.flags
-                            & CFFI_F_ATTR_ONERROR))
-                        goto numargs_error;
-
-                    argObjs[i] =
-                        protoP->params[i].typeAttrs.parseModeSpecificObj;
-                }
+                /*
+                 * No argument, must have a default - parseModeSpecificObj
+                 * is used for both defaults and onerror. Count check
+                 * above would have caught missing non-defaulted args.
+                 */
+                CFFI_ASSERT(protoP->params[i].typeAttrs.parseModeSpecificObj);
+                argObjs[i] = protoP->params[i].typeAttrs.parseModeSpecificObj;
             }
         }
         /*
-         * Now parse varargs arguments. At this point j is start of varargs
-         * within objv[]. i is start of varargs within argObjs[].
+         * Now parse varargs arguments. i is start of varargs
+         * within argObjs[].
          */
         if (nVarArgs) {
+            int j = objArgIndex + planP->nMaxArgs;
             /* Note below assert only holds for varargs functions */
-            CFFI_ASSERT((i + nVarArgs) == nArgObjs);
-            for (; i < nArgObjs; ++i, ++j) {
+            CFFI_ASSERT((i + nVarArgs) == nActualArgs);
+            for (; i < nActualArgs; ++i, ++j) {
                 CFFI_ASSERT(j < objc);
                 Tcl_Obj **typeAndValueObj;
                 Tcl_Size n;
@@ -1949,7 +2242,7 @@ CffiFunctionCall(ClientData cdata,
                      * CffiLibInitProtoCif above */
                     Tclh_ErrorInvalidValue(
                         ip,
-                        varArgObjs[i],
+                        objv[j],
                         "A vararg must be a type and value pair.");
                     goto pop_and_error;
                 }
@@ -1963,27 +2256,9 @@ CffiFunctionCall(ClientData cdata,
             != TCL_OK)
             goto pop_and_error;
         /* callCtx.argsP will have been set up by above call */
-        varArgsInited = 1;
         CFFI_ASSERT(callCtx.nArgs == nActualArgs);
     }
 
-#ifdef _WIN32
-#define SAVEERROR()                                                       \
-    do {                                                                  \
-        if (protoP->returnType.typeAttrs.flags & CFFI_F_ATTR_SAVEERROR) { \
-            ipCtxP->savedWinError = GetLastError();                       \
-            ipCtxP->savedErrno    = errno;                                \
-        }                                                                 \
-    } while (0)
-#else
-#define SAVEERROR()                                                       \
-    do {                                                                  \
-        if (protoP->returnType.typeAttrs.flags & CFFI_F_ATTR_SAVEERROR) { \
-            ipCtxP->savedErrno = errno;                                   \
-        }                                                                 \
-    } while (0)
-#endif
-
     /*
      * A note on pointer disposal - pointers must be disposed of AFTER the
      * function is invoked (since success/fail control disposal) but BEFORE
@@ -2019,8 +2294,7 @@ CffiFunctionCall(ClientData cdata,
         if (protoP->returnType.typeAttrs.flags & CFFI_F_ATTR_REQUIREMENT_MASK) \
             fnCheckRet = CffiCheckNumeric(                                     \
                 ip, &protoP->returnType.typeAttrs, &cretval, &sysError);       \
-        CffiPointerArgsDispose(                                                \
-            ipCtxP, callCtx.nArgs, callCtx.argsP, fnCheckRet);                 \
+        CffiPointerArgsDispose(&callCtx, fnCheckRet);                          \
         if (fnCheckRet == TCL_OK) {                                            \
             /* Wrap function return value unless an output argument is */      \
             /* to be returned as the result or result to be discarded */       \
@@ -2035,12 +2309,13 @@ CffiFunctionCall(ClientData cdata,
     } while (0)
 
     CFFI_ASSERT(ret == TCL_OK);
+    if (startTime)
+        nativeTime = CffiStatsClock();
     switch (protoP->returnType.typeAttrs.dataType.baseType) {
     case CFFI_K_TYPE_VOID:
         CffiCallVoidFunc(&callCtx);
         SAVEERROR();
-        CffiPointerArgsDispose(
-            ipCtxP, callCtx.nArgs, callCtx.argsP, fnCheckRet);
+        CffiPointerArgsDispose(&callCtx, fnCheckRet);
         if (!discardResult)
             resultObj = Tcl_NewObj();
         break;
@@ -2101,7 +2376,7 @@ CffiFunctionCall(ClientData cdata,
         /* Do check IMMEDIATELY so as to not lose GetLastError */
         fnCheckRet = CffiCheckPointer(
             ip, &protoP->returnType.typeAttrs, pointer, &sysError);
-        CffiPointerArgsDispose(ipCtxP, callCtx.nArgs, callCtx.argsP, fnCheckRet);         \
+        CffiPointerArgsDispose(&callCtx, fnCheckRet);
         switch (protoP->returnType.typeAttrs.dataType.baseType) {
         case CFFI_K_TYPE_POINTER:
             if (!discardResult)
@@ -2152,7 +2427,7 @@ CffiFunctionCall(ClientData cdata,
             SAVEERROR();
             fnCheckRet = CffiCheckPointer(
                 ip, &protoP->returnType.typeAttrs, pointer, &sysError);
-            CffiPointerArgsDispose(ipCtxP, callCtx.nArgs, callCtx.argsP, fnCheckRet);
+            CffiPointerArgsDispose(&callCtx, fnCheckRet);
             if (pointer == NULL) {
                 CffiStruct *structP =
                     protoP->returnType.typeAttrs.dataType.u.structP;
@@ -2230,6 +2505,8 @@ CffiFunctionCall(ClientData cdata,
         ret = TCL_ERROR;
         break;
     }
+    if (startTime)
+        nativeTime = CffiStatsClock() - nativeTime;
 
     /*
      * At this point, the state of the call is reflected by the
@@ -2277,6 +2554,23 @@ CffiFunctionCall(ClientData cdata,
     if (resultObj)
         Tcl_IncrRefCount(resultObj);
 
+    /*
+     * For outdict functions, the function result, unless void or
+     * discarded, and outputs are collected into a dictionary.
+     */
+    outDictObj = NULL;
+    if (ret == TCL_OK && fnCheckRet == TCL_OK
+        && (protoP->returnType.typeAttrs.flags & CFFI_F_ATTR_OUTDICT)) {
+        outDictObj = Tcl_NewDictObj();
+        Tcl_IncrRefCount(outDictObj);
+        if (resultObj
+            && protoP->returnType.typeAttrs.dataType.baseType
+                   != CFFI_K_TYPE_VOID) {
+            Tcl_DictObjPut(
+                NULL, outDictObj, Tcl_NewStringObj("return", 6), resultObj);
+        }
+    }
+
     if (ret == TCL_OK) {
         /*
          * Store parameters based on function return conditions.
@@ -2284,26 +2578,56 @@ CffiFunctionCall(ClientData cdata,
          * Note only fixed params considered, not varargs. For now that's
          * fine since varargs are currently never INOUT or OUT parameters.
          */
-        for (i = 0; i < protoP->nParams; ++i) {
-            /* Skip the index, if any, that is to be returned as function result */
-            if (i != argResultIndex) {
-                CffiAttrFlags flags = protoP->params[i].typeAttrs.flags;
-                if ((flags & (CFFI_F_ATTR_INOUT | CFFI_F_ATTR_OUT))) {
-                    if ((fnCheckRet == TCL_OK
-                         && !(flags & CFFI_F_ATTR_STOREONERROR))
-                        || (fnCheckRet != TCL_OK
-                            && (flags & CFFI_F_ATTR_STOREONERROR))
-                        || (flags & CFFI_F_ATTR_STOREALWAYS)) {
-                        /* Parameter needs to be stored */
-                        if (CffiArgPostProcess(&callCtx, i, NULL) != TCL_OK)
-                            ret = TCL_ERROR;/* Only update ret on error! */
-                    }
+        int k;
+        /*
+         * The call plan output list excludes the retval parameter. Outputs
+         * of outdict functions are only returned on success.
+         */
+        for (k = 0; k < planP->nOutputs; ++k) {
+            CffiAttrFlags flags;
+            i     = planP->outputIndices[k];
+            flags = protoP->params[i].typeAttrs.flags;
+            CFFI_ASSERT(i != argResultIndex);
+            CFFI_ASSERT(flags & (CFFI_F_ATTR_INOUT | CFFI_F_ATTR_OUT));
+            if (outDictObj) {
+                Tcl_Obj *outValObj = NULL;
+                if (!(flags & CFFI_F_ATTR_STOREONERROR)) {
+                    if (CffiArgPostProcess(&callCtx, i, &outValObj) != TCL_OK)
+                        ret = TCL_ERROR; /* Only update ret on error! */
+                    else if (outValObj)
+                        Tcl_DictObjPut(NULL,
+                                       outDictObj,
+                                       protoP->params[i].nameObj,
+                                       outValObj);
                 }
             }
+            else if (protoP->returnType.typeAttrs.flags & CFFI_F_ATTR_OUTDICT) {
+                /* Failed outdict call. Out params have no variables. */
+                continue;
+            }
+            else if ((fnCheckRet == TCL_OK && !(flags & CFFI_F_ATTR_STOREONERROR))
+                || (fnCheckRet != TCL_OK && (flags & CFFI_F_ATTR_STOREONERROR))
+                || (flags & CFFI_F_ATTR_STOREALWAYS)) {
+                /* Parameter needs to be stored */
+                if (CffiArgPostProcess(&callCtx, i, NULL) != TCL_OK)
+                    ret = TCL_ERROR; /* Only update ret on error! */
+            }
         }
     }
     /* Parameters stored away. Note ret might have changed to error */
 
+    /* The dictionary of outputs replaces the function result */
+    if (outDictObj) {
+        if (ret == TCL_OK) {
+            if (resultObj)
+                Tclh_ObjClearPtr(&resultObj);
+            resultObj     = outDictObj;
+            discardResult = 0;
+        }
+        else
+            Tcl_DecrRefCount(outDictObj);
+    }
+
     /* 
      * See if a parameter output value is to be returned as function result
      * Note this will overrided the discard annotation.
@@ -2349,12 +2673,10 @@ CffiFunctionCall(ClientData cdata,
         CffiArgCleanup(&callCtx, i);
 
 pop_and_go:
-    /* Clean up the temporary type descriptors for varargs */
-    if (varArgsInited && varArgTypesP) {
-        for (i = 0; i < nVarArgs; ++i) {
-            CffiTypeAndAttrsCleanup(&varArgTypesP[i]);
-        }
-    }
+    if (varargsSigP)
+        CffiVarargsSigUnref(varargsSigP);
+    if (startTime)
+        CffiStatsRecord(fnP, ret, startTime, nativeTime);
 
     CffiFunctionUnref(fnP);
     Tclh_LifoPopMark(mark);
@@ -2367,8 +2689,11 @@ numargs_error:
     for (i = 0; i < objArgIndex; ++i)
         Tcl_ListObjAppendElement(NULL, resultObj, objv[i]);
     for (i = 0; i < protoP->nParams; ++i) {
-        /* RETVAL params are "invisible" from caller's perspective */
-        if (! (protoP->params[i].typeAttrs.flags & CFFI_F_ATTR_RETVAL))
+        /*
+         * RETVAL params and outdict out params are "invisible" from
+         * caller's perspective
+         */
+        if (planP->args[i].objIndex >= 0)
             Tcl_ListObjAppendElement(
                 NULL, resultObj, protoP->params[i].nameObj);
     }
@@ -2408,6 +2733,7 @@ CffiFunctionNew(CffiInterpCtx *ipCtxP,
     if (cmdNameObj)
         Tcl_IncrRefCount(cmdNameObj);
     fnP->cmdNameObj = cmdNameObj;
+    fnP->statsP     = NULL;
     return fnP;
 }
 
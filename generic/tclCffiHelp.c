@@ -88,6 +88,10 @@ CffiHelpFunctionCmd(CffiInterpCtx *ipCtxP, Tcl_Obj *fnNameObj)
             retvalIndex = i;
             continue;
         }
+        /* outdict out params are returned, not passed */
+        if ((protoP->returnType.typeAttrs.flags & CFFI_F_ATTR_OUTDICT)
+            && (protoP->params[i].typeAttrs.flags & CFFI_F_ATTR_OUT))
+            continue;
         if (protoP->params[i].typeAttrs.parseModeSpecificObj)
             Tcl_AppendStringsToObj(resultObj,
                                    " ?",
@@ -108,6 +112,8 @@ CffiHelpFunctionCmd(CffiInterpCtx *ipCtxP, Tcl_Obj *fnNameObj)
         Tcl_AppendStringsToObj(
             resultObj, " -> ", Tcl_GetString(retvalObj), NULL);
         Tcl_DecrRefCount(retvalObj);
+    } else if (protoP->returnType.typeAttrs.flags & CFFI_F_ATTR_OUTDICT) {
+        Tcl_AppendStringsToObj(resultObj, " -> dict", NULL);
     } else {
         if (protoP->returnType.typeAttrs.dataType.baseType != CFFI_K_TYPE_VOID
             && !(protoP->returnType.typeAttrs.flags & CFFI_F_ATTR_DISCARD)) {
@@ -149,6 +149,10 @@ CFFI_INLINE int CffiTypeIsInteger(CffiBaseType type) {
     return (type >= CFFI_K_FIRST_INTEGER_TYPE
             && type <= CFFI_K_LAST_INTEGER_TYPE);
 }
+CFFI_INLINE int CffiTypeIsNumeric(CffiBaseType type) {
+    return CffiTypeIsInteger(type) || type == CFFI_K_TYPE_FLOAT
+        || type == CFFI_K_TYPE_DOUBLE;
+}
 
 
 /*
@@ -243,6 +247,9 @@ typedef enum CffiAttrFlags {
     CFFI_F_ATTR_MULTISZ          = 0x02000000, /* Windows multisz */
     CFFI_F_ATTR_SAVEERROR        = 0x04000000, /* Save error codes after call */
     CFFI_F_ATTR_PINNED           = 0x08000000, /* Pinned pointer*/
+    CFFI_F_ATTR_OUTDICT          = 0x10000000, /* Return outputs as a dict */
+    CFFI_F_ATTR_VECTOR           = 0x20000000, /* Return arrays as vectors */
+    CFFI_F_ATTR_PACKED           = 0x40000000, /* Arrays as native bytes */
 } CffiAttrFlags;
 
 /*
@@ -343,8 +350,40 @@ typedef enum CffiStructFlags {
     CFFI_F_STRUCT_VARSIZE      = 0x0002, /* Variable size struct */
     CFFI_F_STRUCT_UNION        = 0x0004, /* Is a union */
     CFFI_F_STRUCT_HASSIZEFIELD = 0x0008, /* Has field with structsize */
+    CFFI_F_STRUCT_PLAINDATA    = 0x0010, /* Fixed size, fields convertible
+                                            without interp or dereferencing */
+    CFFI_F_STRUCT_NOFLAT       = 0x0020, /* Not converted through a
+                                            flattened program */
 } CffiStructFlags;
 
+/* Field values for structs up to this size are collected on the C stack */
+#define CFFI_K_STRUCT_FIELDS_ON_STACK 32
+
+/*
+ * Struct: CffiStructFlatOp
+ * Instruction in the flattened program for converting a struct with
+ * nested structs to a script value. The program is in postfix order.
+ * Leaf operations push the converted value of a field at an offset from
+ * the outermost struct. Dictionary and list operations pop the values
+ * for their elements and push the constructed value.
+ */
+typedef enum CffiStructFlatOpKind {
+    CFFI_K_FLAT_LEAF, /* Convert a non-struct field */
+    CFFI_K_FLAT_DICT, /* Construct a struct dictionary from its fields */
+    CFFI_K_FLAT_LIST  /* Construct a list from an array of structs */
+} CffiStructFlatOpKind;
+typedef struct CffiStructFlatOp {
+    CffiStructFlatOpKind kind;
+    int offset;   /* LEAF - offset of field from start of outer struct */
+    int count;    /* LEAF - field array size, LIST - number of elements */
+    union {
+        const CffiTypeAndAttrs *typeAttrsP; /* LEAF - type of field */
+        const CffiStruct *structP;          /* DICT - supplies field names */
+    } u;
+} CffiStructFlatOp;
+/* Structs needing more than these many operations are not flattened */
+#define CFFI_K_STRUCT_FLAT_MAX_OPS 256
+
 /* Struct: CffiStruct
  * Descriptor for a struct and union layout.
  *
@@ -370,6 +409,21 @@ struct CffiStruct {
     int dynamicCountFieldIndex; /* Index into fields[] of field holding
                                    array size of variable-sized last field.
                                    -1 if not variable size */
+    int vlaCountOffset;       /* Offset of the VLA count field from the
+                                 start of the struct, following nested
+                                 variable size structs. -1 if fixed size */
+    CffiBaseType vlaCountBaseType; /* Type of the field at vlaCountOffset */
+    Tcl_HashTable fieldIndex; /* Field name -> index into fields[] */
+    CffiStructFlatOp *flatOpsP; /* Flattened conversion program, built on
+                                   first use. NULL if not built */
+    int nFlatOps;             /* Number of operations in flatOpsP */
+    void *poolFreeP;          /* Free list of pooled allocations, linked
+                                 through their first word */
+    int poolMax;              /* Max allocations retained in the free list.
+                                 0 disables pooling */
+    int poolFree;             /* Number of allocations in the free list */
+    Tcl_WideUInt poolHits;    /* Allocations served from the free list */
+    Tcl_WideUInt poolMisses;  /* Pooled allocations needing ckalloc */
     int nFields;              /* Cardinality of fields[] */
     CffiField fields[1];      /* Actual count given by nFields */
     /* !!!DO NOT ADD FIELDS HERE!!! */
@@ -429,6 +483,23 @@ typedef struct CffiInterpCtx {
 
     Tclh_LibContext *tclhCtxP;
 
+    unsigned int typeEpoch;   /* Incremented on any change to alias, enum,
+                                 struct or union definitions, including
+                                 renaming or deleting a struct or union
+                                 command. Invalidates cached type parses */
+
+    int nAsyncCalls;          /* Asynchronous calls not yet completed.
+                                 Protected by the async call mutex */
+    Tcl_Condition asyncCond;  /* Signalled as async calls complete */
+
+    Tcl_HashTable pooledBlocks; /* Struct allocations from pools handed out
+                                   to the script -> allocated size */
+    unsigned int viewId;      /* Used to generate struct view command names */
+    Tcl_HashTable pointerWatches; /* Pointer -> list of CffiPointerWatch */
+
+    int collectStats;         /* If true, collect function call statistics */
+    struct CffiFunctionStats *statsP; /* List of statistics being collected */
+
     int savedErrno;
 #ifdef _WIN32
     DWORD savedWinError;
@@ -460,6 +531,38 @@ typedef struct CffiStructCmdCtx {
     CffiStruct *structP;
 } CffiStructCmdCtx;
 
+/* Struct: CffiStructAccessor
+ * Context for a command accessing a single field of a struct
+ */
+typedef struct CffiStructAccessor {
+    CffiInterpCtx *ipCtxP;
+    CffiStruct *structP;  /* Struct containing the field. Holds a reference */
+    int fldIndex;         /* Index of field in structP->fields[] */
+    int safe;             /* If non-0, pointers must be registered */
+} CffiStructAccessor;
+
+/* Struct: CffiPointerWatch
+ * Tracks disposal of a pointer bound to a command. Linked into
+ * CffiInterpCtx.pointerWatches by <CffiPointerWatchAdd>.
+ */
+typedef struct CffiPointerWatch {
+    struct CffiPointerWatch *nextP; /* Next watch on the same pointer */
+    void *pointer;        /* Pointer being watched */
+    int disposed;         /* Set once the pointer has been disposed of */
+} CffiPointerWatch;
+
+/* Struct: CffiStructView
+ * Context for a command bound to a native struct
+ */
+typedef struct CffiStructView {
+    CffiInterpCtx *ipCtxP;
+    CffiStruct *structP;  /* Struct type of the view. Holds a reference */
+    void *pointer;        /* Pointer the view was created from */
+    void *structAddr;     /* Address of the struct, after indexing */
+    CffiPointerWatch watch; /* Only linked for safe views */
+    int safe;             /* If non-0, pointer must stay registered */
+} CffiStructView;
+
 /* Struct: CffiParam
  * Descriptor for a function parameter
  */
@@ -471,6 +574,98 @@ typedef struct CffiParam {
                                 the array size. */
 } CffiParam;
 
+/*
+ * Marshalling operations for a fixed parameter in a call plan.
+ */
+typedef enum CffiArgOp {
+    CFFI_K_ARGOP_PREPARE,  /* Generic - full CffiArgPrepare processing */
+    CFFI_K_ARGOP_SCALARIN, /* Numeric scalar input passed by value */
+    CFFI_K_ARGOP_VLA,      /* Array sized by another parameter */
+    CFFI_K_ARGOP_RETVAL,   /* Output returned as the function result */
+} CffiArgOp;
+
+/*
+ * Maximum number of parameters for a function to be eligible for the
+ * scalar call path which keeps arguments on the C stack.
+ */
+#define CFFI_K_MAX_SCALAR_PARAMS 8
+
+/* Struct: CffiArgPlan
+ * Precompiled marshalling step for a single fixed parameter.
+ */
+typedef struct CffiArgPlan {
+    CffiArgOp op;     /* How the argument is to be marshalled */
+    int objIndex;     /* Position of the script argument relative to the
+                         first argument. -1 for CFFI_K_ARGOP_RETVAL
+                         and for out params of outdict functions */
+    int flags;
+#define CFFI_F_ARGPLAN_NATIVEDEFAULT 0x1 /* defaultValue holds the converted
+                                            default for the parameter */
+    CffiValue defaultValue; /* Native default value for a
+                               CFFI_K_ARGOP_SCALARIN parameter */
+} CffiArgPlan;
+
+/* Struct: CffiCallPlan
+ * Call plan compiled from a prototype at definition time.
+ *
+ * The plan caches everything about a prototype that does not change
+ * between calls - argument count limits, the parameter returned as the
+ * function result, parameters needing post-call output or pointer disposal
+ * and the marshalling operation for each parameter. This saves
+ * *CffiFunctionCall* from re-deriving these on every invocation.
+ *
+ * The index arrays are allocated as part of the same block as the plan.
+ */
+typedef struct CffiCallPlan {
+    int flags;
+#define CFFI_F_PLAN_SCALAR 0x1 /* Only scalar in params and return so
+                                  eligible for CffiFunctionCallScalar.
+                                  Defaulted params all have native
+                                  defaults */
+#define CFFI_F_PLAN_REORDERED 0x2 /* prepareOrder[] is not the identity */
+    int nMinArgs;        /* Minimum number of script level arguments */
+    int nMaxArgs;        /* Maximum number of script level arguments for
+                            the fixed parameters */
+    int retvalIndex;     /* Index of parameter annotated as retval or -1 */
+    int nOutputs;        /* Size of outputIndices[] */
+    int *outputIndices;  /* Indices of out and inout parameters excluding
+                            the retval parameter */
+    int nDisposables;    /* Size of disposeIndices[] */
+    int *disposeIndices; /* Indices of pointer parameters annotated with
+                            dispose or disposeonsuccess */
+    int nVLAs;           /* Number of CFFI_K_ARGOP_VLA parameters */
+    int *prepareOrder;   /* Order in which to prepare the parameters such
+                            that counts for dynamic arrays come before the
+                            arrays */
+    CffiArgPlan args[1]; /* Real size is number of fixed params (at least 1) */
+    /* !!!DO NOT ADD FIELDS HERE AT END OF STRUCT!!! */
+} CffiCallPlan;
+
+/* Struct: CffiVarargsSig
+ * Parsed vararg types for one vararg type signature of a prototype.
+ *
+ * Varargs functions are typically called with only a few distinct
+ * combinations of vararg types. Each prototype therefore keeps a short
+ * list of these, most recently used first, so the type definitions need
+ * not be parsed (and for libffi, the call descriptor not prepared) on
+ * every call. The signature is the list of vararg type definitions together
+ * with the namespace in which they were resolved and the interpreter type
+ * epoch at the time. See <CffiVarargsSigLookup>.
+ */
+typedef struct CffiVarargsSig {
+    struct CffiVarargsSig *nextP; /* Next entry in LRU order */
+    Tcl_Namespace *nsP;           /* Namespace the types were resolved in */
+    unsigned int typeEpoch;       /* CffiInterpCtx.typeEpoch at parse time */
+    int nRefs;                    /* Cache reference plus calls in progress */
+    int nVarArgs;                 /* Number of varargs in signature */
+    CffiTypeAndAttrs *varArgTypesP; /* Parsed types [nVarArgs] */
+    Tcl_Obj **typeObjs;           /* Type definitions [nVarArgs] */
+#ifdef CFFI_USE_LIBFFI
+    ffi_cif *cifP;                /* libffi descriptor for the signature */
+#endif
+} CffiVarargsSig;
+#define CFFI_K_VARARGS_CACHE_SIZE 8 /* Max signatures cached per prototype */
+
 /* Struct: CffiProto
  * Descriptor for a function prototype including parameters and return
  * types. Note this is a variable size structure as the number of
@@ -484,8 +679,10 @@ typedef struct CffiProto {
     CffiABIProtocol abi;  /* cdecl, stdcall etc. */
     CffiParam returnType; /* Name and return type of function */
 #ifdef CFFI_USE_LIBFFI
-    ffi_cif *cifP; /* Descriptor used by cffi */
+    ffi_cif *cifP; /* Descriptor used by cffi. Not used for varargs */
 #endif
+    CffiVarargsSig *varargsSigsP; /* Cached vararg signatures, MRU first */
+    CffiCallPlan *planP;  /* Compiled call plan. See CffiProtoCompilePlan */
     CffiParam params[1]; /* Real size depends on nparams which
                              may even be 0!*/
     /* !!!DO NOT ADD FIELDS HERE AT END OF STRUCT!!! */
@@ -508,9 +705,30 @@ typedef struct CffiFunction {
     CffiLibCtx *libCtxP;   /* Containing library for bound functions or
                               NULL for free standing functions */
     Tcl_Obj *cmdNameObj;   /* Name of Tcl command. May be NULL */
+    struct CffiFunctionStats *statsP; /* Call statistics. Allocated on first
+                                         call with statistics enabled */
     int nRefs;             /* Reference count */
 } CffiFunction;
 
+/* Struct: CffiFunctionStats
+ * Call statistics for a function. Times are in nanoseconds.
+ */
+#define CFFI_K_STATS_NBUCKETS 32
+typedef struct CffiFunctionStats {
+    struct CffiFunctionStats *nextP; /* Links in CffiInterpCtx.statsP */
+    struct CffiFunctionStats *prevP;
+    CffiFunction *fnP;         /* Owning function */
+    Tcl_WideUInt nCalls;       /* Number of calls */
+    Tcl_WideUInt nErrors;      /* Number of calls raising errors */
+    Tcl_WideUInt totalTime;    /* Cumulative time for the command */
+    Tcl_WideUInt nativeTime;   /* Cumulative time within the C function */
+    Tcl_WideUInt maxTotalTime;
+    Tcl_WideUInt maxNativeTime;
+    Tcl_WideUInt histogram[CFFI_K_STATS_NBUCKETS]; /* Element i counts calls
+                                   whose native time t has 2^i <= t < 2^(i+1).
+                                   Last bucket also counts anything larger */
+} CffiFunctionStats;
+
 /* Struct: CffiArgument
  * Storage for argument values for a function call.
  */
@@ -538,9 +756,14 @@ typedef struct CffiArgument {
 } CffiArgument;
 
 
+#define CFFI_K_METHOD_CACHE_SIZE 4
 typedef struct CffiInterfaceMember {
     CffiProto *protoP;
     Tcl_Obj *methodNameObj;
+    int nextCacheIndex; /* Entry in fnCache to replace on a miss */
+    CffiFunction *fnCache[CFFI_K_METHOD_CACHE_SIZE]; /* Function descriptors
+                           for implementations of the method, keyed by
+                           their address. Unused entries are NULL */
 } CffiInterfaceMember;
 
 /* Struct: CffiInterface
@@ -555,6 +778,8 @@ typedef struct CffiInterface {
     int nMethods; /* Size of vtable[] */
     int nInheritedMethods; /* Number of inherited methods in vtable */
     CffiInterfaceMember *vtable;
+    const char **methodNames; /* NULL terminated method names for lookup
+                                 from bound instances. Lazily initialized */
 } CffiInterface;
 CFFI_INLINE void CffiInterfaceRef(CffiInterface *ifcP) {
     ifcP->nRefs += 1;
@@ -569,15 +794,30 @@ typedef struct CffiMethod {
     int vtableSlot;        /* Method slot in interface vtable */
 } CffiMethod;
 
+/* Struct: CffiBoundInstance
+ * Contains an interface instance pointer bound to a command
+ */
+typedef struct CffiBoundInstance {
+    CffiInterface *ifcP;   /* Interface of the instance */
+    Tcl_Obj *ptrObj;       /* Instance pointer. Validated when bound */
+    void *instanceP;       /* Instance address */
+    CffiPointerWatch watch; /* Marks the command stale on dispose */
+} CffiBoundInstance;
+
 /* Struct: CffiCall
  * Complete context for a call invocation
  */
 typedef struct CffiCall {
     CffiFunction *fnP;         /* Function being called */
 #ifdef CFFI_USE_LIBFFI
+    ffi_cif *cifP;      /* Call descriptor. Per vararg signature for varargs */
     void **argValuesPP; /* Array of pointers into the actual value fields within
                            argsP[] elements */
     CffiValue retValue; /* Holds return value */
+#endif
+#ifdef CFFI_USE_DYNCALL
+    int deferLoad;      /* If set, prepared arguments are not pushed on to
+                           the dyncall stack. See CffiFunctionSetupArgs */
 #endif
     void *retValueP;    /* Points to storage to use for return value */
     int nArgs;             /* Size of argsP. */
@@ -648,6 +888,10 @@ CffiResult CffiTypeAndAttrsParse(CffiInterpCtx *ipCtxP,
                                  Tcl_Obj *typeAttrObj,
                                  CffiTypeParseMode parseMode,
                                  CffiTypeAndAttrs *typeAttrsP);
+CffiResult CffiTypeAndAttrsParseCached(CffiInterpCtx *ipCtxP,
+                                       Tcl_Obj *typeAttrObj,
+                                       CffiTypeParseMode parseMode,
+                                       CffiTypeAndAttrs *typeAttrsP);
 void CffiTypeAndAttrsCleanup(CffiTypeAndAttrs *typeAttrsP);
 Tcl_Obj *CffiTypeUnparse(const CffiType *typeP);
 Tcl_Obj *CffiTypeAndAttrsUnparse(const CffiTypeAndAttrs *typeAttrsP);
@@ -664,6 +908,7 @@ void CffiStructUnref(CffiStruct *structP);
 CffiResult CffiErrorStructIsVariableSize(Tcl_Interp *ip, CffiStruct *structP, const char *oper);
 CffiResult CffiErrorMissingVLACountOption(Tcl_Interp *ip);
 CffiResult CffiErrorStructCountField(Tcl_Interp *ip, Tcl_Obj *fldNameObj);
+void CffiStructPoolForget(CffiInterpCtx *ipCtxP, void *p);
 
 CffiResult CffiStructSizeForObj(CffiInterpCtx *ipCtxP,
                                 const CffiStruct *structP,
@@ -762,6 +1007,13 @@ CffiResult CffiNativeValueToObj(CffiInterpCtx *ipCtxP,
                                 int startIndex,
                                 int count,
                                 Tcl_Obj **valueObjP);
+CffiResult CffiNumericArrayFromObjs(Tcl_Interp *ip,
+                                    CffiBaseType baseType,
+                                    Tcl_Obj *const *valueObjs,
+                                    Tcl_Size nValues,
+                                    void *valueP);
+Tcl_Obj *
+CffiNumericArrayToObj(CffiBaseType baseType, const void *valueP, Tcl_Size count);
 Tcl_Obj *CffiMakePointerTagFromObj(CffiInterpCtx *ipCtxP, Tcl_Obj *tagObj);
 Tcl_Obj *
 CffiMakePointerTag(CffiInterpCtx *, const char *tagP, Tcl_Size tagLen);
@@ -782,6 +1034,11 @@ CffiResult CffiPointerFromObj(CffiInterpCtx *ipCtxP,
                               const CffiTypeAndAttrs *typeAttrsP,
                               Tcl_Obj *pointerObj,
                               void **pointerP);
+void CffiPointerWatchAdd(CffiInterpCtx *ipCtxP,
+                         CffiPointerWatch *watchP,
+                         void *pointer);
+void CffiPointerWatchRemove(CffiInterpCtx *ipCtxP, CffiPointerWatch *watchP);
+void CffiPointerWatchesInvalidate(CffiInterpCtx *ipCtxP, void *pointer);
 
 CffiResult
 CffiGetEncodingFromObj(Tcl_Interp *ip, Tcl_Obj *encObj, Tcl_Encoding *encP);
@@ -821,6 +1078,13 @@ CffiResult CffiPrototypeParse(CffiInterpCtx *ipCtxP,
                               Tcl_Obj **paramObjs,
                               CffiProto **protoPP);
 void CffiProtoUnref(CffiProto *protoP);
+void CffiProtoCompilePlan(CffiInterpCtx *ipCtxP, CffiProto *protoP);
+CffiResult CffiVarargsSigLookup(CffiInterpCtx *ipCtxP,
+                                CffiProto *protoP,
+                                int nVarArgs,
+                                Tcl_Obj *const *varArgObjs,
+                                CffiVarargsSig **sigPP);
+void CffiVarargsSigUnref(CffiVarargsSig *sigP);
 void CffiPrototypesCleanup(CffiInterpCtx *ipCtxP);
 CffiProto *
 CffiProtoGet(CffiInterpCtx *ipCtxP, Tcl_Obj *protoNameObj);
@@ -899,6 +1163,24 @@ CffiResult CffiNameDeleteNames(Tcl_Interp *ip,
 CffiResult CffiArenaInit(CffiInterpCtx *ipCtxP);
 void CffiArenaFinit(CffiInterpCtx *ipCtxP);
 
+/* Asynchronous calls */
+void CffiAsyncFinit(CffiInterpCtx *ipCtxP);
+
+/* Call statistics */
+Tcl_WideUInt CffiStatsClock(void);
+void CffiStatsRecord(CffiFunction *fnP,
+                     CffiResult ret,
+                     Tcl_WideUInt startTime,
+                     Tcl_WideUInt nativeTime);
+void CffiStatsFree(CffiFunction *fnP);
+void CffiStatsFinit(CffiInterpCtx *ipCtxP);
+
+/* Typed vectors */
+Tcl_Obj *
+CffiVectorNewObj(CffiBaseType baseType, const void *valueP, Tcl_Size count);
+const void *
+CffiVectorData(Tcl_Obj *objP, CffiBaseType baseType, Tcl_Size *countP);
+
 #ifdef CFFI_USE_DYNCALL
 
 CffiResult CffiDyncallInit(CffiInterpCtx *ipCtxP);
@@ -923,10 +1205,6 @@ CFFI_INLINE CffiABIProtocol CffiStdcallABI() {
 }
 
 CffiResult CffiDyncallAggrInit(CffiInterpCtx *ipCtxP, CffiStruct *structP);
-CffiResult CffiDyncallVarargsInit(CffiInterpCtx *ipCtxP,
-                                  int numVarArgs,
-                                  Tcl_Obj *const *varArgObjs,
-                                  CffiTypeAndAttrs *varArgTypesP);
 
 #define CffiReloadArg CffiDyncallReloadArg
 void CffiDyncallReloadArg(CffiCall *callP,
@@ -962,7 +1240,8 @@ DEFINEFN_(DCpointer, CffiCallPointerFunc, dcCallPointer)
 #define STOREARGFN_(name_, type_, storefn_) \
 CFFI_INLINE void CffiStoreArg ## name_ (CffiCall *callP, int ix, type_ val) \
 { \
-    storefn_(callP->fnP->ipCtxP->vmP, val); \
+    if (!callP->deferLoad) \
+        storefn_(callP->fnP->ipCtxP->vmP, val); \
 }
 STOREARGFN_(Pointer, void*, dcArgPointer)
 STOREARGFN_(SChar, signed char, dcArgChar)
@@ -987,11 +1266,12 @@ STOREARGFN_(Double, double, dcArgDouble)
 CffiResult CffiLibffiInit(CffiInterpCtx *ipCtxP);
 void CffiLibffiFinit(CffiInterpCtx *ipCtxP);
 
-CffiResult CffiLibffiInitProtoCif(CffiInterpCtx *ipCtxP,
-                                  CffiProto *protoP,
-                                  int numVarArgs,
-                                  Tcl_Obj * const *varArgObjs,
-                                  CffiTypeAndAttrs *typeAttrsP);
+CffiResult CffiLibffiInitProtoCif(CffiInterpCtx *ipCtxP, CffiProto *protoP);
+CffiResult CffiLibffiPrepCif(CffiInterpCtx *ipCtxP,
+                             CffiProto *protoP,
+                             int numVarArgs,
+                             CffiTypeAndAttrs *varArgTypesP,
+                             ffi_cif **cifPP);
 
 # ifdef CFFI_HAVE_CALLBACKS
 void CffiLibffiCallback(ffi_cif *cifP, void *retP, void **args, void *userdata);
@@ -1022,7 +1302,7 @@ CFFI_INLINE CffiResult CffiResetCall(Tcl_Interp *ip, CffiCall *callP) {
 }
 
 CFFI_INLINE void CffiLibffiCall(CffiCall *callP) {
-    ffi_call(callP->fnP->protoP->cifP,
+    ffi_call(callP->cifP,
              callP->fnP->fnAddr,
              callP->retValueP,
              callP->argValuesPP);
@@ -1094,6 +1374,9 @@ CFFI_INLINE void CffiFunctionUnref(CffiFunction *fnP) {
         ckfree(fnP);
     }
 }
+CffiResult CffiFunctionFromObj(CffiInterpCtx *ipCtxP,
+                               Tcl_Obj *fnObj,
+                               CffiFunction **fnPP);
 CffiResult CffiDefineOneFunctionFromLib(Tcl_Interp *ip,
                                         CffiLibCtx *libCtxP,
                                         Tcl_Obj *nameObj,
@@ -1107,6 +1390,7 @@ Tcl_ObjCmdProc CffiInterfaceInstanceCmd;
 
 Tcl_ObjCmdProc CffiAliasObjCmd;
 Tcl_ObjCmdProc CffiArenaObjCmd;
+Tcl_ObjCmdProc CffiAsyncObjCmd;
 Tcl_ObjCmdProc CffiDyncallSymbolsObjCmd;
 Tcl_ObjCmdProc CffiEnumObjCmd;
 Tcl_ObjCmdProc CffiHelpObjCmd;
@@ -1114,9 +1398,11 @@ Tcl_ObjCmdProc CffiInterfaceObjCmd;
 Tcl_ObjCmdProc CffiMemoryObjCmd;
 Tcl_ObjCmdProc CffiPointerObjCmd;
 Tcl_ObjCmdProc CffiPrototypeObjCmd;
+Tcl_ObjCmdProc CffiStatsObjCmd;
 Tcl_ObjCmdProc CffiStructObjCmd;
 Tcl_ObjCmdProc CffiTypeObjCmd;
 Tcl_ObjCmdProc CffiUnionObjCmd;
+Tcl_ObjCmdProc CffiVectorObjCmd;
 Tcl_ObjCmdProc CffiWrapperObjCmd;
 
 #ifdef CFFI_HAVE_CALLBACKS
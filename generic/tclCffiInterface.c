@@ -22,11 +22,18 @@ void CffiInterfaceUnref(CffiInterface *ifcP)
             CffiInterfaceUnref(ifcP->baseIfcP);
         if (ifcP->vtable) {
             for (i = 0; i < ifcP->nMethods; ++i) {
+                int j;
+                for (j = 0; j < CFFI_K_METHOD_CACHE_SIZE; ++j) {
+                    if (ifcP->vtable[i].fnCache[j])
+                        CffiFunctionUnref(ifcP->vtable[i].fnCache[j]);
+                }
                 CffiProtoUnref(ifcP->vtable[i].protoP);
                 Tcl_DecrRefCount(ifcP->vtable[i].methodNameObj);
             }
             Tcl_Free((char *) ifcP->vtable);
         }
+        if (ifcP->methodNames)
+            Tcl_Free((char *) ifcP->methodNames);
         Tcl_Free((char *) ifcP);
     }
 }
@@ -72,32 +79,37 @@ notfound:
     return TCL_ERROR;
 }
 
-CffiResult
-CffiMethodInstanceCmd(ClientData cdata,
-                      Tcl_Interp *ip,
-                      int objc,
-                      Tcl_Obj *const objv[])
+/* Function: CffiInterfaceInstanceFromObj
+ * Validates an interface instance pointer
+ *
+ * Parameters:
+ * ip - interpreter
+ * ifcP - interface
+ * ptrObj - pointer to an instance of the interface
+ * instancePP - location to store the instance address
+ *
+ * The pointer must be a registered non-NULL pointer whose tag is the
+ * interface or implicitly castable to it.
+ *
+ * Returns:
+ * *TCL_OK* on success with the instance address stored in *instancePP*,
+ * or *TCL_ERROR* on error with message in interpreter.
+ */
+static CffiResult
+CffiInterfaceInstanceFromObj(Tcl_Interp *ip,
+                             CffiInterface *ifcP,
+                             Tcl_Obj *ptrObj,
+                             void **instancePP)
 {
-    CffiMethod *methodP = (CffiMethod *)cdata;
-    CffiInterpCtx *ipCtxP = (CffiInterpCtx *)methodP->ifcP->ipCtxP;
-    CffiFunction *fnP;
     CffiResult ret;
     void *instanceP;
     Tclh_PointerTagRelation tagRelation;
     Tclh_PointerRegistrationStatus registration;
 
-    CHECK_NARGS(ip, 2, INT_MAX, "ifcPtr ?ARG ...?");
-
-    /* Sanity check */
-    if (methodP->vtableSlot >= methodP->ifcP->nMethods) {
-        Tcl_SetResult(ip, "Internal error: invalid vtable slot", TCL_STATIC);
-        return TCL_ERROR;
-    }
-
     ret = Tclh_PointerObjDissect(ip,
-                           ipCtxP->tclhCtxP,
-                           objv[1],
-                           methodP->ifcP->nameObj,
+                           ifcP->ipCtxP->tclhCtxP,
+                           ptrObj,
+                           ifcP->nameObj,
                            &instanceP,
                            NULL,
                            &tagRelation,
@@ -114,7 +126,7 @@ CffiMethodInstanceCmd(ClientData cdata,
     case TCLH_TAG_RELATION_UNRELATED:
     case TCLH_TAG_RELATION_EXPLICITLY_CASTABLE:
     default:
-        return Tclh_ErrorPointerObjType(ip, objv[1], methodP->ifcP->nameObj);
+        return Tclh_ErrorPointerObjType(ip, ptrObj, ifcP->nameObj);
     }
 
     switch (registration) {
@@ -125,9 +137,41 @@ CffiMethodInstanceCmd(ClientData cdata,
     case TCLH_POINTER_REGISTRATION_WRONGTAG:
     default:
         return Tclh_ErrorPointerObjRegistration(
-            ip, objv[1], registration);
+            ip, ptrObj, registration);
     }
 
+    *instancePP = instanceP;
+    return TCL_OK;
+}
+
+/* Function: CffiInterfaceMethodFunction
+ * Returns the function descriptor for a method of an instance
+ *
+ * Parameters:
+ * ifcP - interface
+ * vtableSlot - method slot in the interface vtable
+ * instanceP - instance address
+ *
+ * Descriptors are cached per method keyed by the address of the method
+ * implementation so calls on instances sharing an implementation do not
+ * allocate.
+ *
+ * *NOTE:* The reference count on the returned descriptor is *not*
+ * incremented. The caller should do that while making the call.
+ *
+ * Returns:
+ * Pointer to the function descriptor.
+ */
+static CffiFunction *
+CffiInterfaceMethodFunction(CffiInterface *ifcP,
+                            int vtableSlot,
+                            void *instanceP)
+{
+    CffiInterfaceMember *memberP = &ifcP->vtable[vtableSlot];
+    CffiFunction *fnP;
+    void *fnAddr;
+    int i;
+
     /*
      * The instance pointer points to a area of memory which starts with a
      * pointer to the method table for the instance.
@@ -135,11 +179,49 @@ CffiMethodInstanceCmd(ClientData cdata,
     typedef int (*fnptr)();
     typedef fnptr *vtableptr;
     vtableptr instanceVtablePtr = *(vtableptr *)instanceP;
-    fnP = CffiFunctionNew(ipCtxP,
-                          methodP->ifcP->vtable[methodP->vtableSlot].protoP,
-                          NULL,
-                          NULL,
-                          instanceVtablePtr[methodP->vtableSlot]);
+    fnAddr = instanceVtablePtr[vtableSlot];
+
+    for (i = 0; i < CFFI_K_METHOD_CACHE_SIZE; ++i) {
+        fnP = memberP->fnCache[i];
+        if (fnP && fnP->fnAddr == fnAddr)
+            return fnP;
+    }
+
+    /* Not cached. Replace entries in round robin fashion */
+    fnP = CffiFunctionNew(ifcP->ipCtxP, memberP->protoP, NULL, NULL, fnAddr);
+    CffiFunctionRef(fnP);
+    i = memberP->nextCacheIndex;
+    if (memberP->fnCache[i])
+        CffiFunctionUnref(memberP->fnCache[i]);
+    memberP->fnCache[i]     = fnP;
+    memberP->nextCacheIndex = (i + 1) % CFFI_K_METHOD_CACHE_SIZE;
+    return fnP;
+}
+
+CffiResult
+CffiMethodInstanceCmd(ClientData cdata,
+                      Tcl_Interp *ip,
+                      int objc,
+                      Tcl_Obj *const objv[])
+{
+    CffiMethod *methodP = (CffiMethod *)cdata;
+    CffiFunction *fnP;
+    CffiResult ret;
+    void *instanceP;
+
+    CHECK_NARGS(ip, 2, INT_MAX, "ifcPtr ?ARG ...?");
+
+    /* Sanity check */
+    if (methodP->vtableSlot >= methodP->ifcP->nMethods) {
+        Tcl_SetResult(ip, "Internal error: invalid vtable slot", TCL_STATIC);
+        return TCL_ERROR;
+    }
+
+    CHECK(CffiInterfaceInstanceFromObj(
+        ip, methodP->ifcP, objv[1], &instanceP));
+
+    fnP = CffiInterfaceMethodFunction(
+        methodP->ifcP, methodP->vtableSlot, instanceP);
     CffiFunctionRef(fnP);
     ret = CffiFunctionCall(fnP, ip, 1, objc, objv);
     CffiFunctionUnref(fnP);
@@ -147,6 +229,77 @@ CffiMethodInstanceCmd(ClientData cdata,
     return ret;
 }
 
+/* Function: CffiBoundInstanceCmd
+ * Implements the command created by the *bind* method of an interface.
+ *
+ * Parameters:
+ * cdata - <CffiBoundInstance>
+ * ip - interpreter
+ * objc - count of elements in objv
+ * objv - BOUNDCMD METHOD ?ARG ...?
+ *
+ * The instance pointer is parsed and its tag checked when bound, not on
+ * every call. The command is instead marked stale through
+ * <CffiPointerWatchesInvalidate> when the instance is disposed of so the
+ * method table of a freed instance is never accessed.
+ *
+ * Returns:
+ * TCL_OK on success with result in interpreter or TCL_ERROR with error
+ * message in interpreter.
+ */
+static CffiResult
+CffiBoundInstanceCmd(ClientData cdata,
+                     Tcl_Interp *ip,
+                     int objc,
+                     Tcl_Obj *const objv[])
+{
+    CffiBoundInstance *boundP = (CffiBoundInstance *)cdata;
+    CffiInterface *ifcP       = boundP->ifcP;
+    CffiInterpCtx *ipCtxP     = ifcP->ipCtxP;
+    CffiFunction *fnP;
+    Tcl_Obj **argObjs;
+    Tclh_LifoMark mark;
+    CffiResult ret;
+    int vtableSlot;
+
+    CHECK_NARGS(ip, 2, INT_MAX, "METHOD ?ARG ...?");
+    CHECK(Tcl_GetIndexFromObj(
+        ip, objv[1], ifcP->methodNames, "method", TCL_EXACT, &vtableSlot));
+    if (boundP->watch.disposed) {
+        return Tclh_ErrorGeneric(
+            ip,
+            NULL,
+            "The instance bound to the command has been disposed of.");
+    }
+
+    /* Arguments are the command, method, instance pointer and the rest */
+    mark    = Tclh_LifoPushMark(&ipCtxP->memlifo);
+    argObjs = Tclh_LifoAlloc(&ipCtxP->memlifo, (objc + 1) * sizeof(Tcl_Obj *));
+    argObjs[0] = objv[0];
+    argObjs[1] = objv[1];
+    argObjs[2] = boundP->ptrObj;
+    if (objc > 2)
+        memcpy(&argObjs[3], &objv[2], (objc - 2) * sizeof(Tcl_Obj *));
+
+    fnP = CffiInterfaceMethodFunction(ifcP, vtableSlot, boundP->instanceP);
+    CffiFunctionRef(fnP);
+    ret = CffiFunctionCall(fnP, ip, 2, objc + 1, argObjs);
+    CffiFunctionUnref(fnP);
+
+    Tclh_LifoPopMark(mark);
+    return ret;
+}
+
+static void
+CffiBoundInstanceDeleter(ClientData cdata)
+{
+    CffiBoundInstance *boundP = (CffiBoundInstance *)cdata;
+    CffiPointerWatchRemove(boundP->ifcP->ipCtxP, &boundP->watch);
+    CffiInterfaceUnref(boundP->ifcP);
+    Tcl_DecrRefCount(boundP->ptrObj);
+    Tcl_Free((char *)boundP);
+}
+
 static CffiResult
 CffiInterfaceDestroyCmd(Tcl_Interp *ip,
                         int objc,
@@ -229,6 +382,7 @@ CffiInterfaceMethodsHelper(Tcl_Interp *ip,
     CffiInterfaceMember *ifcMembers;
     ifcMembers =
         (CffiInterfaceMember *)Tcl_Alloc(sizeof(*ifcMembers) * totalSlots);
+    memset(ifcMembers, 0, sizeof(*ifcMembers) * totalSlots);
 
     Tcl_Obj *params[256]; /* Assume max number of fixed params is 254 */
 
@@ -384,6 +538,73 @@ CffiInterfaceStdMethodsCmd(Tcl_Interp *ip,
     return CffiInterfaceMethodsHelper(ip, objc, objv, ifcP, CffiStdcallABI());
 }
 
+/* Function: CffiInterfaceBindCmd
+ * Creates a command bound to an instance of an interface.
+ *
+ * Parameters:
+ * ip - interpreter
+ * objc - count of elements in objv
+ * objv - INTERFACE bind CMDNAME IFCPTR
+ * ifcP - interface
+ *
+ * The created command invokes methods of the interface on the instance
+ * without the instance pointer having to be passed and checked on every
+ * call.
+ *
+ * Returns:
+ * TCL_OK on success with the fully qualified command name as result or
+ * TCL_ERROR with error message in interpreter.
+ */
+static CffiResult
+CffiInterfaceBindCmd(Tcl_Interp *ip,
+                     int objc,
+                     Tcl_Obj *const objv[],
+                     CffiInterface *ifcP)
+{
+    CffiBoundInstance *boundP;
+    Tcl_Obj *cmdNameObj;
+    void *instanceP;
+    int i;
+
+    CFFI_ASSERT(objc == 4);
+
+    if (ifcP->vtable == NULL) {
+        return Tclh_ErrorNotFound(
+            ip, "Interface method table", ifcP->nameObj, NULL);
+    }
+    CHECK(CffiInterfaceInstanceFromObj(ip, ifcP, objv[3], &instanceP));
+
+    /* Method name table for Tcl_GetIndexFromObj, shared by bound instances */
+    if (ifcP->methodNames == NULL) {
+        ifcP->methodNames = (const char **)Tcl_Alloc(
+            (ifcP->nMethods + 1) * sizeof(*ifcP->methodNames));
+        for (i = 0; i < ifcP->nMethods; ++i) {
+            ifcP->methodNames[i] =
+                Tcl_GetString(ifcP->vtable[i].methodNameObj);
+        }
+        ifcP->methodNames[i] = NULL;
+    }
+
+    boundP            = (CffiBoundInstance *)Tcl_Alloc(sizeof(*boundP));
+    boundP->ifcP      = ifcP;
+    boundP->instanceP = instanceP;
+    boundP->ptrObj    = objv[3];
+    Tcl_IncrRefCount(boundP->ptrObj);
+    CffiInterfaceRef(ifcP);
+    CffiPointerWatchAdd(ifcP->ipCtxP, &boundP->watch, instanceP);
+
+    cmdNameObj = Tclh_NsQualifyNameObj(ip, objv[2], NULL);
+    Tcl_IncrRefCount(cmdNameObj);
+    Tcl_CreateObjCommand(ip,
+                         Tcl_GetString(cmdNameObj),
+                         CffiBoundInstanceCmd,
+                         boundP,
+                         CffiBoundInstanceDeleter);
+    Tcl_SetObjResult(ip, cmdNameObj);
+    Tcl_DecrRefCount(cmdNameObj);
+    return TCL_OK;
+}
+
 CffiResult
 CffiInterfaceInstanceCmd(ClientData cdata,
                          Tcl_Interp *ip,
@@ -392,16 +613,19 @@ CffiInterfaceInstanceCmd(ClientData cdata,
 {
     CffiInterface *ifcP = (CffiInterface *)cdata;
     static const Tclh_SubCommand subCommands[] = {
+        {"bind", 2, 2, "CMDNAME IFCPTR", CffiInterfaceBindCmd},
         {"destroy", 0, 0, "", CffiInterfaceDestroyCmd},
         {"id", 0, 0, "", NULL},
         {"methods", 1, 3, "", CffiInterfaceMethodsCmd},
         {"stdmethods", 1, 3, "", CffiInterfaceStdMethodsCmd},
         {NULL}};
-    enum cmdOpt { DESTROY, ID, METHODS, STDMETHODS };
+    enum cmdOpt { BIND, DESTROY, ID, METHODS, STDMETHODS };
     int cmdIndex;
 
     CHECK(Tclh_SubCommandLookup(ip, subCommands, objc, objv, &cmdIndex));
     switch (cmdIndex) {
+    case BIND:
+        return CffiInterfaceBindCmd(ip, objc, objv, ifcP);
     case DESTROY:
         return CffiInterfaceDestroyCmd(ip, objc, objv, ifcP);
     case ID:
@@ -472,6 +696,7 @@ CffiInterfaceCreateCmd(ClientData cdata,
     ifcP->nMethods          = 0;
     ifcP->nInheritedMethods = 0;
     ifcP->vtable            = NULL;
+    ifcP->methodNames       = NULL;
 
     ifcP->nameObj = Tclh_NsQualifyNameObj(ip, objv[2], NULL);
     Tcl_IncrRefCount(ifcP->nameObj);
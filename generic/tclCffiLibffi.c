@@ -180,35 +180,39 @@ invalid_type:
         ip, NULL, "Unknown type or invalid type for context.");
 }
 
+/* Function: CffiLibffiPrepCif
+ * Prepares a libffi call descriptor for a prototype.
+ *
+ * Parameters:
+ * ipCtxP - interpreter context
+ * protoP - prototype
+ * numVarArgs - number of varargs. Must be 0 for non-varargs prototypes.
+ * varArgTypesP - parsed types of the varargs. May be NULL if *numVarArgs*
+ *    is 0.
+ * cifPP - location to store the allocated descriptor. Must be freed with
+ *    ckfree.
+ *
+ * Returns:
+ * Returns TCL_OK on success and TCL_ERROR on failure with error message
+ * in the interpreter.
+ */
 CffiResult
-CffiLibffiInitProtoCif(CffiInterpCtx *ipCtxP,
-                       CffiProto *protoP,
-                       int numVarArgs,
-                       Tcl_Obj * const *varArgObjs,
-                       CffiTypeAndAttrs *varArgTypesP)
+CffiLibffiPrepCif(CffiInterpCtx *ipCtxP,
+                  CffiProto *protoP,
+                  int numVarArgs,
+                  CffiTypeAndAttrs *varArgTypesP,
+                  ffi_cif **cifPP)
 {
     Tcl_Interp *ip = ipCtxP->interp;
     ffi_cif *cifP;
     ffi_type **ffiTypePP;
-    CffiResult ret;
+    ffi_status ffiStatus;
     int i;
     int totalSlots;
 
     CFFI_ASSERT((protoP->flags & CFFI_F_PROTO_VARARGS) || numVarArgs == 0);
-    CFFI_ASSERT(numVarArgs == 0 || varArgObjs);
     CFFI_ASSERT(numVarArgs == 0 || varArgTypesP);
 
-    /*
-     * For varargs, arguments may keep changing so we have to regenerate the
-     * libffi argument descriptors on every call.
-     */
-    if (protoP->cifP) {
-        if (! (protoP->flags & CFFI_F_PROTO_VARARGS))
-            return TCL_OK; /* Not a varargs function, and already init'ed */
-        ckfree(protoP->cifP);
-        protoP->cifP = NULL;
-    }
-
     /* Need space for cif itself, fixed params, varargs, return value */
     totalSlots = protoP->nParams + numVarArgs + 1;
     cifP       = ckalloc(sizeof(*cifP) + (sizeof(ffi_type *) * totalSlots));
@@ -216,92 +220,81 @@ CffiLibffiInitProtoCif(CffiInterpCtx *ipCtxP,
     /* Map fixed argument CFFI types to libffi types */
     ffiTypePP = (ffi_type **)(cifP + 1);
     for (i = 0; i < protoP->nParams; ++i) {
-        ret = CffiTypeToLibffiType(ip,
-                                   protoP->abi,
-                                   CFFI_F_TYPE_PARSE_PARAM,
-                                   &protoP->params[i].typeAttrs,
-                                   &ffiTypePP[i]);
-        if (ret != TCL_OK)
+        if (CffiTypeToLibffiType(ip,
+                                 protoP->abi,
+                                 CFFI_F_TYPE_PARSE_PARAM,
+                                 &protoP->params[i].typeAttrs,
+                                 &ffiTypePP[i])
+            != TCL_OK)
+            goto error_handler;
+    }
+    /* Map vararg types. These follow the fixed parameters */
+    for (i = 0; i < numVarArgs; ++i) {
+        if (CffiTypeToLibffiType(ip,
+                                 protoP->abi,
+                                 CFFI_F_TYPE_PARSE_PARAM,
+                                 &varArgTypesP[i],
+                                 &ffiTypePP[protoP->nParams + i])
+            != TCL_OK)
             goto error_handler;
     }
     /* Map return type. Place at end of all arguments (fixed and varargs) */
-    ret = CffiTypeToLibffiType(ip,
-                               protoP->abi,
-                               CFFI_F_TYPE_PARSE_RETURN,
-                               &protoP->returnType.typeAttrs,
-                               &ffiTypePP[numVarArgs+protoP->nParams]);
-    if (ret != TCL_OK)
+    if (CffiTypeToLibffiType(ip,
+                             protoP->abi,
+                             CFFI_F_TYPE_PARSE_RETURN,
+                             &protoP->returnType.typeAttrs,
+                             &ffiTypePP[numVarArgs + protoP->nParams])
+        != TCL_OK)
         goto error_handler;
 
-    /*
-     * Finally, gather up the vararg types. Unlike the fixed parameters,
-     * here the types are specified at call time so need to parse those
-     */
-    int numVarArgTypesInited;
-    for (numVarArgTypesInited = 0, i = 0; i < numVarArgs; ++i) {
-        /* The varargs arguments are pairs consisting of type and value. */
-        Tcl_Obj **argObjs;
-        Tcl_Size n;
-        if (Tcl_ListObjGetElements(NULL, varArgObjs[i], &n, &argObjs) != TCL_OK
-            || n != 2) {
-            Tclh_ErrorInvalidValue(
-                ip, varArgObjs[i], "A vararg must be a type and value pair.");
-            goto error_handler;
-        }
-        ret = CffiTypeAndAttrsParse(
-            ipCtxP, argObjs[0], CFFI_F_TYPE_PARSE_PARAM, &varArgTypesP[i]);
-        if (ret != TCL_OK)
-            break;
-        ++numVarArgTypesInited; /* So correct number is cleaned on error */
-
-        ret = CffiCheckVarargType(ip, &varArgTypesP[i], argObjs[0]);
-        if (ret != TCL_OK)
-            break;
-
-        ret = CffiTypeToLibffiType(ip,
-                                   protoP->abi,
-                                   CFFI_F_TYPE_PARSE_PARAM,
-                                   &varArgTypesP[i],
-                                   &ffiTypePP[protoP->nParams + i]);
-        if (ret != TCL_OK)
-            break;
-    }
-    if (ret == TCL_OK) {
-        ffi_status ffiStatus;
-        if (protoP->flags & CFFI_F_PROTO_VARARGS) {
-            ffiStatus = ffi_prep_cif_var(cifP,
-                                     protoP->abi,
-                                     protoP->nParams,
-                                     numVarArgs+protoP->nParams,
-                                     ffiTypePP[numVarArgs+protoP->nParams],
-                                     ffiTypePP);
-        }
-        else {
-            ffiStatus = ffi_prep_cif(cifP,
+    if (protoP->flags & CFFI_F_PROTO_VARARGS) {
+        ffiStatus = ffi_prep_cif_var(cifP,
                                      protoP->abi,
                                      protoP->nParams,
-                                     ffiTypePP[protoP->nParams],
+                                     numVarArgs + protoP->nParams,
+                                     ffiTypePP[numVarArgs + protoP->nParams],
                                      ffiTypePP);
-        }
-        if (ffiStatus == FFI_OK) {
-            protoP->cifP = cifP;
-            return TCL_OK;
-        }
-
-        /* Fall through for error handling */
-        CffiMapLibffiError(ip, ffiStatus, NULL);
     }
-
-    /* Error in vararg type conversion or cif prep. Clean any varargs types */
-    for (i = 0; i < numVarArgTypesInited; ++i) {
-        CffiTypeAndAttrsCleanup(&varArgTypesP[i]);
+    else {
+        ffiStatus = ffi_prep_cif(cifP,
+                                 protoP->abi,
+                                 protoP->nParams,
+                                 ffiTypePP[protoP->nParams],
+                                 ffiTypePP);
     }
+    if (ffiStatus == FFI_OK) {
+        *cifPP = cifP;
+        return TCL_OK;
+    }
+    CffiMapLibffiError(ip, ffiStatus, NULL);
 
 error_handler:
     ckfree(cifP);
     return TCL_ERROR;
 }
 
+/* Function: CffiLibffiInitProtoCif
+ * Lazily initializes the libffi call descriptor for a prototype.
+ *
+ * Parameters:
+ * ipCtxP - interpreter context
+ * protoP - prototype. Must not be a varargs prototype as the descriptors
+ *    for those depend on the vararg types and are held in the vararg
+ *    signature cache. See <CffiVarargsSigLookup>.
+ *
+ * Returns:
+ * Returns TCL_OK on success and TCL_ERROR on failure with error message
+ * in the interpreter.
+ */
+CffiResult
+CffiLibffiInitProtoCif(CffiInterpCtx *ipCtxP, CffiProto *protoP)
+{
+    CFFI_ASSERT(!(protoP->flags & CFFI_F_PROTO_VARARGS));
+    if (protoP->cifP)
+        return TCL_OK;
+    return CffiLibffiPrepCif(ipCtxP, protoP, 0, NULL, &protoP->cifP);
+}
+
 void
 CffiLibffiCallbackCleanup(CffiCallback *cbP)
 {
@@ -508,7 +501,7 @@ CffiLibffiCallbackInit(CffiInterpCtx *ipCtxP,
                        CffiProto *protoP,
                        CffiCallback *cbP)
 {
-    CHECK(CffiLibffiInitProtoCif(ipCtxP, protoP, 0, NULL, NULL));
+    CHECK(CffiLibffiInitProtoCif(ipCtxP, protoP));
 
     void *closureP = NULL;
     void *executableAddr;
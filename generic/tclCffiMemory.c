@@ -174,8 +174,11 @@ CffiMemoryFreeCmd(CffiInterpCtx *ipCtxP,
     if (pv == NULL)
         return TCL_OK;
     ret = Tclh_PointerUnregister(ip, ipCtxP->tclhCtxP, pv);
-    if (ret == TCL_OK)
+    if (ret == TCL_OK) {
+        CffiPointerWatchesInvalidate(ipCtxP, pv);
+        CffiStructPoolForget(ipCtxP, pv);
         ckfree(pv);
+    }
     return ret;
 }
 
@@ -677,7 +680,7 @@ CffiMemoryGetCmd(CffiInterpCtx *ipCtxP,
 
     CHECK(CffiMemoryAddressFromObj(ipCtxP, objv[2], flags & CFFI_F_ALLOW_UNSAFE, &pv));
 
-    CHECK(CffiTypeAndAttrsParse(
+    CHECK(CffiTypeAndAttrsParseCached(
         ipCtxP, objv[3], CFFI_F_TYPE_PARSE_FIELD, &typeAttrs));
     /* Note typeAttrs needs to be cleaned up beyond this point */
 
@@ -737,7 +740,7 @@ CffiMemorySetCmd(CffiInterpCtx *ipCtxP,
     CHECK(CffiMemoryAddressFromObj(
         ipCtxP, objv[2], flags & CFFI_F_ALLOW_UNSAFE, &pv));
 
-    CHECK(CffiTypeAndAttrsParse(
+    CHECK(CffiTypeAndAttrsParseCached(
         ipCtxP, objv[3], CFFI_F_TYPE_PARSE_FIELD, &typeAttrs));
     /* Note typeAttrs needs to be cleaned up beyond this point */
 
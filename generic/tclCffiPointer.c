@@ -298,14 +298,22 @@ CffiPointerObjCmd(ClientData cdata,
         }
         return ret;
     case DISPOSE:
-        if (pv)
-            return Tclh_PointerUnregisterTagged(
+        if (pv) {
+            ret = Tclh_PointerUnregisterTagged(
                 ip, ipCtxP->tclhCtxP, pv, objP);
+            if (ret == TCL_OK)
+                CffiPointerWatchesInvalidate(ipCtxP, pv);
+            return ret;
+        }
         return TCL_OK;
     case INVALIDATE:
-        if (pv)
-            return Tclh_PointerInvalidateTagged(
+        if (pv) {
+            ret = Tclh_PointerInvalidateTagged(
                 ip, ipCtxP->tclhCtxP, pv, objP);
+            if (ret == TCL_OK)
+                CffiPointerWatchesInvalidate(ipCtxP, pv);
+            return ret;
+        }
         return TCL_OK;
     default: /* Just to keep compiler happy */
         Tcl_SetResult(
@@ -314,3 +322,95 @@ CffiPointerObjCmd(ClientData cdata,
     }
 }
 
+/* Function: CffiPointerWatchAdd
+ * Starts tracking disposal of a pointer bound to a command.
+ *
+ * Parameters:
+ * ipCtxP - interpreter context
+ * watchP - watch to link in. Must stay allocated until
+ *   <CffiPointerWatchRemove> is called on it.
+ * pointer - the pointer to watch
+ */
+void
+CffiPointerWatchAdd(CffiInterpCtx *ipCtxP,
+                    CffiPointerWatch *watchP,
+                    void *pointer)
+{
+    Tcl_HashEntry *heP;
+    int isNew;
+
+    watchP->pointer  = pointer;
+    watchP->disposed = 0;
+    heP = Tcl_CreateHashEntry(&ipCtxP->pointerWatches, pointer, &isNew);
+    watchP->nextP = isNew ? NULL : Tcl_GetHashValue(heP);
+    Tcl_SetHashValue(heP, watchP);
+}
+
+/* Function: CffiPointerWatchRemove
+ * Stops tracking disposal of a pointer.
+ *
+ * Parameters:
+ * ipCtxP - interpreter context
+ * watchP - watch previously added with <CffiPointerWatchAdd>
+ *
+ * Watches that have already been marked disposed are no longer linked
+ * and are ignored.
+ */
+void
+CffiPointerWatchRemove(CffiInterpCtx *ipCtxP, CffiPointerWatch *watchP)
+{
+    Tcl_HashEntry *heP;
+    CffiPointerWatch *prevP;
+
+    if (watchP->disposed)
+        return;
+    heP = Tcl_FindHashEntry(&ipCtxP->pointerWatches, watchP->pointer);
+    if (heP == NULL)
+        return;
+    prevP = Tcl_GetHashValue(heP);
+    if (prevP == watchP) {
+        if (watchP->nextP)
+            Tcl_SetHashValue(heP, watchP->nextP);
+        else
+            Tcl_DeleteHashEntry(heP);
+        return;
+    }
+    for (; prevP; prevP = prevP->nextP) {
+        if (prevP->nextP == watchP) {
+            prevP->nextP = watchP->nextP;
+            break;
+        }
+    }
+}
+
+/* Function: CffiPointerWatchesInvalidate
+ * Marks all watches on a pointer that has been disposed of.
+ *
+ * Parameters:
+ * ipCtxP - interpreter context
+ * pointer - pointer that has been unregistered
+ *
+ * Must be called after a pointer is unregistered. The watches are only
+ * marked if the pointer is no longer registered, as counted pointers
+ * may still have outstanding references.
+ */
+void
+CffiPointerWatchesInvalidate(CffiInterpCtx *ipCtxP, void *pointer)
+{
+    Tcl_HashEntry *heP;
+    CffiPointerWatch *watchP;
+
+    if (ipCtxP->pointerWatches.numEntries == 0
+        || (heP = Tcl_FindHashEntry(&ipCtxP->pointerWatches, pointer)) == NULL)
+        return;
+    if (Tclh_PointerVerify(NULL, ipCtxP->tclhCtxP, pointer) == TCL_OK)
+        return;
+    watchP = Tcl_GetHashValue(heP);
+    while (watchP) {
+        CffiPointerWatch *nextP = watchP->nextP;
+        watchP->disposed        = 1;
+        watchP->nextP           = NULL;
+        watchP                  = nextP;
+    }
+    Tcl_DeleteHashEntry(heP);
+}
@@ -55,12 +55,411 @@ CffiProtoUnref(CffiProto *protoP)
         if (protoP->cifP)
             ckfree(protoP->cifP);
 #endif
+        while (protoP->varargsSigsP) {
+            CffiVarargsSig *sigP = protoP->varargsSigsP;
+            protoP->varargsSigsP = sigP->nextP;
+            CffiVarargsSigUnref(sigP);
+        }
+        if (protoP->planP)
+            ckfree(protoP->planP);
         ckfree(protoP);
     }
     else
         protoP->nRefs -= 1;
 }
 
+/* Function: CffiVarargsSigUnref
+ * Releases a reference to a vararg signature, freeing it when unreferenced.
+ *
+ * Parameters:
+ * sigP - vararg signature
+ */
+void
+CffiVarargsSigUnref(CffiVarargsSig *sigP)
+{
+    int i;
+
+    if (--sigP->nRefs > 0)
+        return;
+    for (i = 0; i < sigP->nVarArgs; ++i) {
+        CffiTypeAndAttrsCleanup(&sigP->varArgTypesP[i]);
+        Tcl_DecrRefCount(sigP->typeObjs[i]);
+    }
+#ifdef CFFI_USE_LIBFFI
+    if (sigP->cifP)
+        ckfree(sigP->cifP);
+#endif
+    ckfree(sigP);
+}
+
+/* Function: CffiVarargsSigMatch
+ * Checks whether the vararg types passed in a call match a cached signature.
+ *
+ * Parameters:
+ * sigP - vararg signature
+ * nsP - current namespace
+ * typeEpoch - current interpreter type epoch
+ * nVarArgs - number of varargs
+ * varArgObjs - vararg values, each a type and value pair
+ *
+ * Returns:
+ * Non-zero if the signature matches, 0 otherwise.
+ */
+static int
+CffiVarargsSigMatch(CffiVarargsSig *sigP,
+                    Tcl_Namespace *nsP,
+                    unsigned int typeEpoch,
+                    int nVarArgs,
+                    Tcl_Obj *const *varArgObjs)
+{
+    int i;
+
+    if (sigP->nVarArgs != nVarArgs || sigP->nsP != nsP
+        || sigP->typeEpoch != typeEpoch)
+        return 0;
+    for (i = 0; i < nVarArgs; ++i) {
+        Tcl_Obj **pairObjs;
+        Tcl_Size n;
+        Tcl_Size len1, len2;
+        const char *s1, *s2;
+        if (Tcl_ListObjGetElements(NULL, varArgObjs[i], &n, &pairObjs)
+                != TCL_OK
+            || n != 2)
+            return 0;
+        if (pairObjs[0] == sigP->typeObjs[i])
+            continue; /* Usual case - same literal */
+        s1 = Tcl_GetStringFromObj(pairObjs[0], &len1);
+        s2 = Tcl_GetStringFromObj(sigP->typeObjs[i], &len2);
+        if (len1 != len2 || memcmp(s1, s2, len1))
+            return 0;
+    }
+    return 1;
+}
+
+/* Function: CffiVarargsSigLookup
+ * Returns the parsed vararg types for a call to a varargs function.
+ *
+ * Parameters:
+ * ipCtxP - interpreter context
+ * protoP - varargs prototype
+ * nVarArgs - number of varargs passed in the call
+ * varArgObjs - vararg values, each a type and value pair
+ * sigPP - location to store the signature. The caller must release it
+ *    with <CffiVarargsSigUnref> once the call completes.
+ *
+ * The signatures are cached in the prototype, most recently used first,
+ * and the least recently used one discarded when more than
+ * CFFI_K_VARARGS_CACHE_SIZE are present. Entries in use by calls in
+ * progress, e.g. from callbacks, are kept alive by their reference count.
+ *
+ * Returns:
+ * Returns TCL_OK on success and TCL_ERROR on failure with error message
+ * in the interpreter.
+ */
+CffiResult
+CffiVarargsSigLookup(CffiInterpCtx *ipCtxP,
+                     CffiProto *protoP,
+                     int nVarArgs,
+                     Tcl_Obj *const *varArgObjs,
+                     CffiVarargsSig **sigPP)
+{
+    Tcl_Interp *ip = ipCtxP->interp;
+    Tcl_Namespace *nsP = Tcl_GetCurrentNamespace(ip);
+    CffiVarargsSig *sigP;
+    CffiVarargsSig **prevPP;
+    int count;
+    int i;
+
+    CFFI_ASSERT(protoP->flags & CFFI_F_PROTO_VARARGS);
+
+    for (prevPP = &protoP->varargsSigsP, count = 0; (sigP = *prevPP) != NULL;
+         ++count) {
+        if (sigP->typeEpoch != ipCtxP->typeEpoch) {
+            /* Types may resolve differently now. Discard */
+            *prevPP = sigP->nextP;
+            CffiVarargsSigUnref(sigP);
+            --count;
+            continue;
+        }
+        if (CffiVarargsSigMatch(
+                sigP, nsP, ipCtxP->typeEpoch, nVarArgs, varArgObjs)) {
+            if (prevPP != &protoP->varargsSigsP) {
+                /* Move to front */
+                *prevPP              = sigP->nextP;
+                sigP->nextP          = protoP->varargsSigsP;
+                protoP->varargsSigsP = sigP;
+            }
+            sigP->nRefs += 1;
+            *sigPP = sigP;
+            return TCL_OK;
+        }
+        if (count >= CFFI_K_VARARGS_CACHE_SIZE - 1 && sigP->nextP == NULL) {
+            /* Least recently used and no room for a new entry. */
+            *prevPP = NULL;
+            CffiVarargsSigUnref(sigP);
+            break;
+        }
+        prevPP = &sigP->nextP;
+    }
+
+    /* Not cached. Parse the vararg type definitions */
+    sigP = ckalloc(sizeof(*sigP)
+                   + nVarArgs * (sizeof(CffiTypeAndAttrs) + sizeof(Tcl_Obj *)));
+    sigP->nextP        = NULL;
+    sigP->nsP          = nsP;
+    sigP->typeEpoch    = ipCtxP->typeEpoch;
+    sigP->nRefs        = 1;
+    sigP->nVarArgs     = 0; /* Incremented as types are parsed for cleanup */
+    sigP->varArgTypesP = (CffiTypeAndAttrs *)(sigP + 1);
+    sigP->typeObjs     = (Tcl_Obj **)(sigP->varArgTypesP + nVarArgs);
+#ifdef CFFI_USE_LIBFFI
+    sigP->cifP = NULL;
+#endif
+    for (i = 0; i < nVarArgs; ++i) {
+        /* The varargs arguments are pairs consisting of type and value. */
+        Tcl_Obj **pairObjs;
+        Tcl_Size n;
+        if (Tcl_ListObjGetElements(NULL, varArgObjs[i], &n, &pairObjs) != TCL_OK
+            || n != 2) {
+            Tclh_ErrorInvalidValue(
+                ip, varArgObjs[i], "A vararg must be a type and value pair.");
+            goto error_handler;
+        }
+        if (CffiTypeAndAttrsParse(ipCtxP,
+                                  pairObjs[0],
+                                  CFFI_F_TYPE_PARSE_PARAM,
+                                  &sigP->varArgTypesP[i])
+            != TCL_OK)
+            goto error_handler;
+        Tcl_IncrRefCount(pairObjs[0]);
+        sigP->typeObjs[i] = pairObjs[0];
+        sigP->nVarArgs += 1;
+        if (CffiCheckVarargType(ip, &sigP->varArgTypesP[i], pairObjs[0])
+            != TCL_OK)
+            goto error_handler;
+    }
+#ifdef CFFI_USE_LIBFFI
+    if (CffiLibffiPrepCif(
+            ipCtxP, protoP, nVarArgs, sigP->varArgTypesP, &sigP->cifP)
+        != TCL_OK)
+        goto error_handler;
+#endif
+
+    /* One reference for the cache, one for the caller */
+    sigP->nRefs          = 2;
+    sigP->nextP          = protoP->varargsSigsP;
+    protoP->varargsSigsP = sigP;
+    *sigPP               = sigP;
+    return TCL_OK;
+
+error_handler:
+    CffiVarargsSigUnref(sigP);
+    return TCL_ERROR;
+}
+
+/* Function: CffiProtoIsScalarOnly
+ * Checks if a prototype is eligible for the scalar call path.
+ *
+ * Parameters:
+ * protoP - prototype
+ * planP - call plan for the prototype with the per-parameter ops filled in
+ *
+ * A prototype is eligible if it has a fixed number of parameters, all of
+ * which are numeric or pointer scalars passed by value as input, and a void
+ * or numeric return type passed by value with no error checking, error
+ * handler or outdict annotations. Any parameter defaults must have been converted to
+ * native form.
+ *
+ * Returns:
+ * Non-zero if eligible, 0 otherwise.
+ */
+static int
+CffiProtoIsScalarOnly(const CffiProto *protoP, const CffiCallPlan *planP)
+{
+    const CffiTypeAndAttrs *typeAttrsP;
+    int i;
+
+    if (CffiProtoIsVarargs((CffiProto *)protoP)
+        || protoP->nParams > CFFI_K_MAX_SCALAR_PARAMS
+        || planP->nMaxArgs != protoP->nParams)
+        return 0;
+
+    typeAttrsP = &protoP->returnType.typeAttrs;
+    if (typeAttrsP->flags
+        & (CFFI_F_ATTR_BYREF | CFFI_F_ATTR_RETVAL | CFFI_F_ATTR_OUTDICT
+           | CFFI_F_ATTR_REQUIREMENT_MASK | CFFI_F_ATTR_ERROR_MASK))
+        return 0;
+    switch (typeAttrsP->dataType.baseType) {
+    case CFFI_K_TYPE_VOID:
+    case CFFI_K_TYPE_FLOAT:
+    case CFFI_K_TYPE_DOUBLE:
+        break;
+    default:
+        if (!CffiTypeIsInteger(typeAttrsP->dataType.baseType))
+            return 0;
+        break;
+    }
+
+    for (i = 0; i < protoP->nParams; ++i) {
+        typeAttrsP = &protoP->params[i].typeAttrs;
+        if (typeAttrsP->parseModeSpecificObj
+            && !(planP->args[i].flags & CFFI_F_ARGPLAN_NATIVEDEFAULT))
+            return 0;
+        if (planP->args[i].op == CFFI_K_ARGOP_SCALARIN)
+            continue;
+        if (typeAttrsP->dataType.baseType != CFFI_K_TYPE_POINTER
+            || CffiTypeIsArray(&typeAttrsP->dataType)
+            || (typeAttrsP->flags & (CFFI_F_ATTR_IN | CFFI_F_ATTR_BYREF))
+                   != CFFI_F_ATTR_IN
+            || (typeAttrsP->flags
+                & (CFFI_F_ATTR_DISPOSE | CFFI_F_ATTR_DISPOSEONSUCCESS)))
+            return 0;
+    }
+    return 1;
+}
+
+/* Function: CffiProtoCompilePlan
+ * Compiles the call plan for a prototype.
+ *
+ * Parameters:
+ * ipCtxP - interpreter context
+ * protoP - fully parsed prototype. Any existing plan is replaced.
+ *
+ * The plan holds the information derived from the prototype that would
+ * otherwise have to be recomputed on every call. See <CffiCallPlan>.
+ * This includes the native values of defaults for numeric parameters.
+ * Conversion only depends on the parsed parameter type, enums included, so
+ * the native values stay valid for the life of the plan. Defaults that
+ * cannot be converted are left to raise errors at call time as before.
+ *
+ * Returns:
+ * Nothing. The plan is stored in *protoP->planP*.
+ */
+void
+CffiProtoCompilePlan(CffiInterpCtx *ipCtxP, CffiProto *protoP)
+{
+    CffiCallPlan *planP;
+    size_t sz;
+    int i;
+    int objIndex;
+    int nSlots;
+
+    /* Index arrays follow the args[] array in the same allocation */
+    nSlots = protoP->nParams ? protoP->nParams : 1;
+    sz     = offsetof(CffiCallPlan, args) + (nSlots * sizeof(planP->args[0]))
+       + (3 * nSlots * sizeof(int));
+    planP = ckalloc(sz);
+    memset(planP, 0, sz);
+    planP->outputIndices  = (int *)&planP->args[nSlots];
+    planP->disposeIndices = planP->outputIndices + nSlots;
+    planP->prepareOrder   = planP->disposeIndices + nSlots;
+    planP->retvalIndex    = -1;
+
+    for (i = 0, objIndex = 0; i < protoP->nParams; ++i) {
+        const CffiTypeAndAttrs *typeAttrsP = &protoP->params[i].typeAttrs;
+        CffiAttrFlags flags                = typeAttrsP->flags;
+        CffiBaseType baseType              = typeAttrsP->dataType.baseType;
+        CffiArgPlan *argPlanP              = &planP->args[i];
+
+        if (flags & CFFI_F_ATTR_RETVAL) {
+            /* No script level argument corresponds to a retval param */
+            argPlanP->op       = CFFI_K_ARGOP_RETVAL;
+            argPlanP->objIndex = -1;
+            planP->retvalIndex = i;
+        }
+        else if ((flags & CFFI_F_ATTR_OUT)
+                 && (protoP->returnType.typeAttrs.flags
+                     & CFFI_F_ATTR_OUTDICT)) {
+            /* Nor to an out param whose value is returned in a dictionary */
+            if (CffiTypeIsVLA(&typeAttrsP->dataType)) {
+                argPlanP->op = CFFI_K_ARGOP_VLA;
+                planP->nVLAs += 1;
+            }
+            else
+                argPlanP->op = CFFI_K_ARGOP_PREPARE;
+            argPlanP->objIndex = -1;
+            planP->outputIndices[planP->nOutputs++] = i;
+        }
+        else {
+            if (CffiTypeIsVLA(&typeAttrsP->dataType)) {
+                argPlanP->op = CFFI_K_ARGOP_VLA;
+                planP->nVLAs += 1;
+            }
+            else if ((flags & (CFFI_F_ATTR_IN | CFFI_F_ATTR_BYREF))
+                         == CFFI_F_ATTR_IN
+                     && CffiTypeIsNotArray(&typeAttrsP->dataType)
+                     && (CffiTypeIsInteger(baseType)
+                         || baseType == CFFI_K_TYPE_FLOAT
+                         || baseType == CFFI_K_TYPE_DOUBLE)) {
+                argPlanP->op = CFFI_K_ARGOP_SCALARIN;
+                if (typeAttrsP->parseModeSpecificObj) {
+                    /* Errors are left to be raised at call time */
+                    Tcl_InterpState savedState =
+                        Tcl_SaveInterpState(ipCtxP->interp, TCL_OK);
+                    if (CffiNativeScalarFromObj(
+                            ipCtxP,
+                            typeAttrsP,
+                            typeAttrsP->parseModeSpecificObj,
+                            0,
+                            &argPlanP->defaultValue,
+                            0,
+                            NULL)
+                        == TCL_OK) {
+                        argPlanP->flags |= CFFI_F_ARGPLAN_NATIVEDEFAULT;
+                    }
+                    Tcl_RestoreInterpState(ipCtxP->interp, savedState);
+                }
+            }
+            else
+                argPlanP->op = CFFI_K_ARGOP_PREPARE;
+            argPlanP->objIndex = objIndex++;
+            /* Arguments without defaults up to this one are mandatory */
+            if (typeAttrsP->parseModeSpecificObj == NULL)
+                planP->nMinArgs = objIndex;
+            if (flags & (CFFI_F_ATTR_OUT | CFFI_F_ATTR_INOUT))
+                planP->outputIndices[planP->nOutputs++] = i;
+        }
+
+        if (baseType == CFFI_K_TYPE_POINTER
+            && (flags & (CFFI_F_ATTR_IN | CFFI_F_ATTR_INOUT))
+            && (flags & (CFFI_F_ATTR_DISPOSE | CFFI_F_ATTR_DISPOSEONSUCCESS))) {
+            planP->disposeIndices[planP->nDisposables++] = i;
+        }
+    }
+    planP->nMaxArgs = objIndex;
+
+    /*
+     * Dynamic arrays must be prepared after the parameter holding their
+     * count. If any count follows its array, prepare all dynamic arrays
+     * after all other parameters. Counts are never themselves arrays.
+     */
+    for (i = 0; i < protoP->nParams; ++i) {
+        planP->prepareOrder[i] = i;
+        if (CffiTypeIsVLA(&protoP->params[i].typeAttrs.dataType)
+            && protoP->params[i].arraySizeParamIndex > i)
+            planP->flags |= CFFI_F_PLAN_REORDERED;
+    }
+    if (planP->flags & CFFI_F_PLAN_REORDERED) {
+        int k = 0;
+        for (i = 0; i < protoP->nParams; ++i) {
+            if (!CffiTypeIsVLA(&protoP->params[i].typeAttrs.dataType))
+                planP->prepareOrder[k++] = i;
+        }
+        for (i = 0; i < protoP->nParams; ++i) {
+            if (CffiTypeIsVLA(&protoP->params[i].typeAttrs.dataType))
+                planP->prepareOrder[k++] = i;
+        }
+        CFFI_ASSERT(k == protoP->nParams);
+    }
+
+    if (CffiProtoIsScalarOnly(protoP, planP))
+        planP->flags |= CFFI_F_PLAN_SCALAR;
+
+    if (protoP->planP)
+        ckfree(protoP->planP);
+    protoP->planP = planP;
+}
+
 /* Function: CffiFindDynamicCountParam
  * Returns the index of the parameter holding a dynamic count
  *
@@ -228,6 +627,14 @@ CffiPrototypeParse(CffiInterpCtx *ipCtxP,
                         "return types with error checking annotations.");
                 }
             }
+            if (protoP->returnType.typeAttrs.flags & CFFI_F_ATTR_OUTDICT) {
+                CffiProtoUnref(protoP);
+                return Tclh_ErrorGeneric(
+                    ip,
+                    NULL,
+                    "The \"retval\" annotation cannot be used in functions "
+                    "with the \"outdict\" return annotation.");
+            }
             /* Mark that return value is through a parameter */
             protoP->returnType.typeAttrs.flags |= CFFI_F_ATTR_RETVAL;
         }
@@ -257,6 +664,8 @@ CffiPrototypeParse(CffiInterpCtx *ipCtxP,
         }
     }
 
+    CffiProtoCompilePlan(ipCtxP, protoP);
+
     *protoPP = protoP;
     return TCL_OK;
 }
@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 2024 Ashok P. Nadkarni
+ * All rights reserved.
+ *
+ * See the file LICENSE for license
+ */
+
+#include "tclCffiInt.h"
+#include <time.h>
+
+/*
+ * Function call statistics.
+ *
+ * Collection is enabled per interpreter through the *cffi::stats* command.
+ * When disabled, the call paths only test CffiInterpCtx.collectStats.
+ * Statistics are allocated for a function on its first call after
+ * collection is enabled and linked into the interpreter context so they
+ * can be enumerated and reset.
+ */
+
+/* Function: CffiStatsClock
+ * Returns a monotonic timestamp in nanoseconds.
+ *
+ * The origin of the timestamp is unspecified so only differences between
+ * values are meaningful.
+ */
+Tcl_WideUInt
+CffiStatsClock(void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER freq; /* Benign race on initialization */
+    LARGE_INTEGER now;
+
+    if (freq.QuadPart == 0)
+        QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    /* Split to avoid overflow of now * 1e9 */
+    return (Tcl_WideUInt)(now.QuadPart / freq.QuadPart) * 1000000000
+         + (Tcl_WideUInt)(now.QuadPart % freq.QuadPart) * 1000000000
+               / freq.QuadPart;
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (Tcl_WideUInt)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+}
+
+/* Function: CffiStatsRecord
+ * Updates the statistics for a function on completion of a call.
+ *
+ * Parameters:
+ * fnP - function that was called
+ * ret - completion status of the call
+ * startTime - <CffiStatsClock> value at start of the call
+ * nativeTime - time spent in the C function, 0 if not called
+ *
+ * Statistics are only kept for functions defined as commands. Function
+ * descriptors created for calls through pointers do not persist.
+ */
+void
+CffiStatsRecord(CffiFunction *fnP,
+                CffiResult ret,
+                Tcl_WideUInt startTime,
+                Tcl_WideUInt nativeTime)
+{
+    CffiInterpCtx *ipCtxP     = fnP->ipCtxP;
+    CffiFunctionStats *statsP = fnP->statsP;
+    Tcl_WideUInt totalTime    = CffiStatsClock() - startTime;
+    Tcl_WideUInt t;
+    int bucket;
+
+    if (fnP->cmdNameObj == NULL)
+        return;
+
+    if (statsP == NULL) {
+        statsP = ckalloc(sizeof(*statsP));
+        memset(statsP, 0, sizeof(*statsP));
+        statsP->fnP  = fnP;
+        statsP->prevP = NULL;
+        statsP->nextP = ipCtxP->statsP;
+        if (ipCtxP->statsP)
+            ipCtxP->statsP->prevP = statsP;
+        ipCtxP->statsP = statsP;
+        fnP->statsP    = statsP;
+    }
+
+    statsP->nCalls += 1;
+    if (ret != TCL_OK)
+        statsP->nErrors += 1;
+    statsP->totalTime += totalTime;
+    statsP->nativeTime += nativeTime;
+    if (totalTime > statsP->maxTotalTime)
+        statsP->maxTotalTime = totalTime;
+    if (nativeTime > statsP->maxNativeTime)
+        statsP->maxNativeTime = nativeTime;
+
+    for (bucket = 0, t = nativeTime;
+         t > 1 && bucket < CFFI_K_STATS_NBUCKETS - 1;
+         t >>= 1) {
+        ++bucket;
+    }
+    statsP->histogram[bucket] += 1;
+}
+
+/* Function: CffiStatsFree
+ * Releases the statistics for a function.
+ *
+ * Parameters:
+ * fnP - function descriptor
+ */
+void
+CffiStatsFree(CffiFunction *fnP)
+{
+    CffiFunctionStats *statsP = fnP->statsP;
+
+    if (statsP == NULL)
+        return;
+    if (statsP->prevP)
+        statsP->prevP->nextP = statsP->nextP;
+    else
+        fnP->ipCtxP->statsP = statsP->nextP;
+    if (statsP->nextP)
+        statsP->nextP->prevP = statsP->prevP;
+    fnP->statsP = NULL;
+    ckfree(statsP);
+}
+
+/* Function: CffiStatsFinit
+ * Releases all statistics for an interpreter.
+ *
+ * Parameters:
+ * ipCtxP - interpreter context
+ *
+ * Functions may outlive the interpreter context since their commands are
+ * deleted later so they are detached from their statistics here.
+ */
+void
+CffiStatsFinit(CffiInterpCtx *ipCtxP)
+{
+    while (ipCtxP->statsP)
+        CffiStatsFree(ipCtxP->statsP->fnP);
+    ipCtxP->collectStats = 0;
+}
+
+/* Function: CffiStatsReset
+ * Clears the statistics for a function.
+ *
+ * Parameters:
+ * statsP - statistics to clear
+ */
+static void
+CffiStatsReset(CffiFunctionStats *statsP)
+{
+    statsP->nCalls        = 0;
+    statsP->nErrors       = 0;
+    statsP->totalTime     = 0;
+    statsP->nativeTime    = 0;
+    statsP->maxTotalTime  = 0;
+    statsP->maxNativeTime = 0;
+    memset(statsP->histogram, 0, sizeof(statsP->histogram));
+}
+
+/* Function: CffiStatsToObj
+ * Returns a dictionary containing function statistics.
+ *
+ * Parameters:
+ * statsP - statistics to wrap. May be NULL if none collected.
+ *
+ * Returns:
+ * A Tcl_Obj with reference count 0.
+ */
+static Tcl_Obj *
+CffiStatsToObj(const CffiFunctionStats *statsP)
+{
+    static const CffiFunctionStats zeroStats;
+    Tcl_Obj *objs[16];
+    Tcl_Obj *histObjs[CFFI_K_STATS_NBUCKETS];
+    int i;
+
+    if (statsP == NULL)
+        statsP = &zeroStats;
+
+#define WIDEOBJ(v_) Tcl_NewWideIntObj((Tcl_WideInt)(v_))
+    objs[0]  = Tcl_NewStringObj("calls", 5);
+    objs[1]  = WIDEOBJ(statsP->nCalls);
+    objs[2]  = Tcl_NewStringObj("errors", 6);
+    objs[3]  = WIDEOBJ(statsP->nErrors);
+    objs[4]  = Tcl_NewStringObj("totaltime", 9);
+    objs[5]  = WIDEOBJ(statsP->totalTime);
+    objs[6]  = Tcl_NewStringObj("nativetime", 10);
+    objs[7]  = WIDEOBJ(statsP->nativeTime);
+    objs[8]  = Tcl_NewStringObj("marshaltime", 11);
+    objs[9]  = WIDEOBJ(statsP->totalTime - statsP->nativeTime);
+    objs[10] = Tcl_NewStringObj("maxtotaltime", 12);
+    objs[11] = WIDEOBJ(statsP->maxTotalTime);
+    objs[12] = Tcl_NewStringObj("maxnativetime", 13);
+    objs[13] = WIDEOBJ(statsP->maxNativeTime);
+    for (i = 0; i < CFFI_K_STATS_NBUCKETS; ++i)
+        histObjs[i] = WIDEOBJ(statsP->histogram[i]);
+    objs[14] = Tcl_NewStringObj("histogram", 9);
+    objs[15] = Tcl_NewListObj(CFFI_K_STATS_NBUCKETS, histObjs);
+#undef WIDEOBJ
+
+    return Tcl_NewListObj(sizeof(objs) / sizeof(objs[0]), objs);
+}
+
+/* Function: CffiStatsFunctionFromObj
+ * Returns the function descriptor for a function command.
+ *
+ * Parameters:
+ * ip - interpreter
+ * fnObj - name of a command defined through the *function* or *stdcall*
+ *    methods of a *Wrapper*
+ * fnPP - location to store the function descriptor
+ *
+ * Function pointers are not accepted as statistics are not kept for them.
+ *
+ * Returns:
+ * Returns TCL_OK on success and TCL_ERROR on failure with error message
+ * in the interpreter.
+ */
+static CffiResult
+CffiStatsFunctionFromObj(Tcl_Interp *ip, Tcl_Obj *fnObj, CffiFunction **fnPP)
+{
+    Tcl_CmdInfo cmdInfo;
+
+    if (Tcl_GetCommandInfo(ip, Tcl_GetString(fnObj), &cmdInfo)
+        && cmdInfo.objProc == CffiFunctionInstanceCmd) {
+        *fnPP = (CffiFunction *)cmdInfo.objClientData;
+        return TCL_OK;
+    }
+    return Tclh_ErrorNotFound(ip, "Function", fnObj, NULL);
+}
+
+/* Function: CffiStatsObjCmd
+ * Implements the *cffi::stats* script level command.
+ *
+ * Parameters:
+ * cdata - interpreter context
+ * ip - interpreter
+ * objc - number of elements in *objv*
+ * objv - array containing the command and arguments
+ *
+ * Returns:
+ * Returns TCL_OK on success and TCL_ERROR on failure with error message
+ * in the interpreter.
+ */
+CffiResult
+CffiStatsObjCmd(ClientData cdata,
+                Tcl_Interp *ip,
+                int objc,
+                Tcl_Obj *const objv[])
+{
+    CffiInterpCtx *ipCtxP = (CffiInterpCtx *)cdata;
+    enum cmds { ENABLE, GET, RESET };
+    int cmdIndex;
+    static Tclh_SubCommand subCommands[] = {
+        {"enable", 0, 1, "?BOOLEAN?", NULL},
+        {"get", 0, 1, "?FUNCTION?", NULL},
+        {"reset", 0, 1, "?FUNCTION?", NULL},
+        {NULL}};
+    CffiFunction *fnP;
+    CffiFunctionStats *statsP;
+    Tcl_Obj *resultObj;
+    int enable;
+
+    CHECK(Tclh_SubCommandLookup(ip, subCommands, objc, objv, &cmdIndex));
+    switch (cmdIndex) {
+    case ENABLE:
+        if (objc > 2) {
+            CHECK(Tcl_GetBooleanFromObj(ip, objv[2], &enable));
+            ipCtxP->collectStats = enable;
+        }
+        Tcl_SetObjResult(ip, Tcl_NewBooleanObj(ipCtxP->collectStats));
+        break;
+
+    case GET:
+        if (objc > 2) {
+            CHECK(CffiStatsFunctionFromObj(ip, objv[2], &fnP));
+            Tcl_SetObjResult(ip, CffiStatsToObj(fnP->statsP));
+        }
+        else {
+            resultObj = Tcl_NewListObj(0, NULL);
+            for (statsP = ipCtxP->statsP; statsP; statsP = statsP->nextP) {
+                CFFI_ASSERT(statsP->fnP->cmdNameObj);
+                Tcl_ListObjAppendElement(
+                    NULL, resultObj, statsP->fnP->cmdNameObj);
+                Tcl_ListObjAppendElement(
+                    NULL, resultObj, CffiStatsToObj(statsP));
+            }
+            Tcl_SetObjResult(ip, resultObj);
+        }
+        break;
+
+    case RESET:
+        if (objc > 2) {
+            CHECK(CffiStatsFunctionFromObj(ip, objv[2], &fnP));
+            if (fnP->statsP)
+                CffiStatsReset(fnP->statsP);
+        }
+        else {
+            for (statsP = ipCtxP->statsP; statsP; statsP = statsP->nextP)
+                CffiStatsReset(statsP);
+        }
+        break;
+    }
+
+    return TCL_OK;
+}
@@ -8,9 +8,328 @@
 #define TCLH_SHORTNAMES
 #include "tclCffiInt.h"
 
+static int CffiStructFieldIndexFromObj(const CffiStruct *structP,
+                                       Tcl_Obj *fieldNameObj);
 static int CffiStructFindField(Tcl_Interp *ip,
                                CffiStruct *structP,
-                               const char *fieldNameP);
+                               Tcl_Obj *fieldNameObj);
+
+/*
+ * Field name Tcl_Obj internal representation caching the index of the
+ * field last looked up. internalRep.longValue holds the index. The index
+ * is verified against the struct on every use so no reference to the
+ * struct is held.
+ */
+static void CffiFieldIndexDupIntRep(Tcl_Obj *srcObj, Tcl_Obj *dstObj);
+static const Tcl_ObjType cffiFieldIndexObjType = {
+    "cffiFieldIndex",
+    NULL,                    /* freeIntRepProc */
+    CffiFieldIndexDupIntRep, /* dupIntRepProc */
+    NULL,                    /* updateStringProc - string rep always kept */
+    NULL,                    /* setFromAnyProc */
+};
+
+static void
+CffiFieldIndexDupIntRep(Tcl_Obj *srcObj, Tcl_Obj *dstObj)
+{
+    dstObj->internalRep.longValue = srcObj->internalRep.longValue;
+    dstObj->typePtr               = &cffiFieldIndexObjType;
+}
+
+/*
+ * Struct value Tcl_Obj internal representation. Struct values returned
+ * to the script hold a copy of the native struct and generate the
+ * dictionary string representation only on demand. Passing the value back
+ * to a native struct of the same type then only needs a copy.
+ * internalRep.twoPtrValue.ptr1 holds the CffiStruct (with a reference)
+ * and ptr2 the native bytes. Only used for CFFI_F_STRUCT_PLAINDATA structs
+ * since the string representation is generated without an interpreter
+ * and after the original native struct may no longer exist.
+ */
+static void CffiStructValueFreeIntRep(Tcl_Obj *objP);
+static void CffiStructValueDupIntRep(Tcl_Obj *srcObj, Tcl_Obj *dstObj);
+static void CffiStructValueUpdateString(Tcl_Obj *objP);
+static const Tcl_ObjType cffiStructValueObjType = {
+    "cffiStructValue",
+    CffiStructValueFreeIntRep,
+    CffiStructValueDupIntRep,
+    CffiStructValueUpdateString,
+    NULL, /* setFromAnyProc - only created from native values */
+};
+static CffiResult CffiStructFieldsToObj(CffiInterpCtx *ipCtxP,
+                                        const CffiStruct *structP,
+                                        void *valueP,
+                                        Tcl_Obj **valueObjP);
+
+static void
+CffiStructValueFreeIntRep(Tcl_Obj *objP)
+{
+    CffiStructUnref((CffiStruct *)objP->internalRep.twoPtrValue.ptr1);
+    ckfree(objP->internalRep.twoPtrValue.ptr2);
+    objP->typePtr = NULL;
+}
+
+static void
+CffiStructValueDupIntRep(Tcl_Obj *srcObj, Tcl_Obj *dstObj)
+{
+    CffiStruct *structP = (CffiStruct *)srcObj->internalRep.twoPtrValue.ptr1;
+    void *valueP        = ckalloc(structP->size);
+
+    memcpy(valueP, srcObj->internalRep.twoPtrValue.ptr2, structP->size);
+    CffiStructRef(structP);
+    dstObj->internalRep.twoPtrValue.ptr1 = structP;
+    dstObj->internalRep.twoPtrValue.ptr2 = valueP;
+    dstObj->typePtr                      = &cffiStructValueObjType;
+}
+
+static void
+CffiStructValueUpdateString(Tcl_Obj *objP)
+{
+    /*
+     * Plain data structs need neither an interpreter nor any other
+     * context for conversion so an empty context suffices. Conversion
+     * cannot fail.
+     */
+    static CffiInterpCtx nullCtx;
+    CffiStruct *structP = (CffiStruct *)objP->internalRep.twoPtrValue.ptr1;
+    Tcl_Obj *dictObj;
+    const char *p;
+    Tcl_Size len;
+
+    if (CffiStructFieldsToObj(&nullCtx,
+                              structP,
+                              objP->internalRep.twoPtrValue.ptr2,
+                              &dictObj)
+        != TCL_OK) {
+        CFFI_ASSERT(0);
+        dictObj = Tcl_NewObj();
+    }
+    p            = Tcl_GetStringFromObj(dictObj, &len);
+    objP->bytes  = ckalloc(len + 1);
+    memcpy(objP->bytes, p, len + 1);
+    objP->length = len;
+    Tcl_DecrRefCount(dictObj);
+}
+
+/* Function: CffiStructValueNewObj
+ * Returns a Tcl_Obj holding a copy of a native plain data struct.
+ *
+ * Parameters:
+ * structP - struct descriptor. Must have CFFI_F_STRUCT_PLAINDATA set.
+ * valueP - native struct to copy
+ *
+ * Returns:
+ * A Tcl_Obj with reference count 0.
+ */
+static Tcl_Obj *
+CffiStructValueNewObj(CffiStruct *structP, const void *valueP)
+{
+    Tcl_Obj *objP = Tcl_NewObj();
+    void *copyP   = ckalloc(structP->size);
+
+    CFFI_ASSERT(structP->flags & CFFI_F_STRUCT_PLAINDATA);
+    memcpy(copyP, valueP, structP->size);
+    Tcl_InvalidateStringRep(objP);
+    CffiStructRef(structP);
+    objP->internalRep.twoPtrValue.ptr1 = structP;
+    objP->internalRep.twoPtrValue.ptr2 = copyP;
+    objP->typePtr                      = &cffiStructValueObjType;
+    return objP;
+}
+
+/* Function: CffiStructIsPlainData
+ * Checks whether a struct can be held as a native value in a Tcl_Obj.
+ *
+ * Parameters:
+ * structP - struct descriptor with all fields defined
+ *
+ * A struct qualifies if it is of fixed size and none of its fields need an
+ * interpreter for conversion to a script value or point to memory outside
+ * the struct.
+ *
+ * Returns:
+ * Non-zero if the struct qualifies, else 0.
+ */
+static int
+CffiStructIsPlainData(const CffiStruct *structP)
+{
+    int i;
+
+    if (structP->flags & (CFFI_F_STRUCT_UNION | CFFI_F_STRUCT_VARSIZE))
+        return 0;
+    for (i = 0; i < structP->nFields; ++i) {
+        const CffiTypeAndAttrs *typeAttrsP = &structP->fields[i].fieldType;
+        switch (typeAttrsP->dataType.baseType) {
+        case CFFI_K_TYPE_SCHAR:
+        case CFFI_K_TYPE_UCHAR:
+        case CFFI_K_TYPE_SHORT:
+        case CFFI_K_TYPE_USHORT:
+        case CFFI_K_TYPE_INT:
+        case CFFI_K_TYPE_UINT:
+        case CFFI_K_TYPE_LONG:
+        case CFFI_K_TYPE_ULONG:
+        case CFFI_K_TYPE_LONGLONG:
+        case CFFI_K_TYPE_ULONGLONG:
+        case CFFI_K_TYPE_FLOAT:
+        case CFFI_K_TYPE_DOUBLE:
+        case CFFI_K_TYPE_CHAR_ARRAY:
+        case CFFI_K_TYPE_UNICHAR_ARRAY:
+        case CFFI_K_TYPE_BYTE_ARRAY:
+        case CFFI_K_TYPE_UUID:
+            break;
+        case CFFI_K_TYPE_POINTER:
+            /* Safe pointers have to be registered at conversion */
+            if (!(typeAttrsP->flags & CFFI_F_ATTR_UNSAFE))
+                return 0;
+            break;
+        case CFFI_K_TYPE_STRUCT:
+            if (!(typeAttrsP->dataType.u.structP->flags
+                  & CFFI_F_STRUCT_PLAINDATA))
+                return 0;
+            break;
+        default:
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/*
+ * Struct allocation pools.
+ *
+ * When enabled through the *pool* method, single fixed size struct
+ * allocations freed through the struct *free* method are retained in a
+ * per-struct free list for reuse instead of being returned to the system.
+ * Allocations are still individually ckalloc'ed so they may be freed with
+ * *memory free* as well. Since a pointer does not carry the size of its
+ * allocation, pooled allocations in use are tracked in
+ * CffiInterpCtx.pooledBlocks and only those are put on a free list.
+ */
+
+/* Function: CffiStructPoolBlockSize
+ * Returns the size of pooled allocations for a struct.
+ *
+ * Parameters:
+ * structP - struct descriptor
+ *
+ * Allocations must be large enough to hold the free list link.
+ */
+static int
+CffiStructPoolBlockSize(const CffiStruct *structP)
+{
+    return structP->size < (int)sizeof(void *) ? (int)sizeof(void *)
+                                               : structP->size;
+}
+
+/* Function: CffiStructPoolAlloc
+ * Allocates memory for a single fixed size struct.
+ *
+ * Parameters:
+ * ipCtxP - interpreter context
+ * structP - struct descriptor. Must not be of variable size.
+ *
+ * The allocation is served from the struct free list if pooling is
+ * enabled. The returned memory must be freed with <CffiStructPoolFree>.
+ *
+ * Returns:
+ * Pointer to the allocated memory.
+ */
+static void *
+CffiStructPoolAlloc(CffiInterpCtx *ipCtxP, CffiStruct *structP)
+{
+    Tcl_HashEntry *heP;
+    void *p;
+    int isNew;
+
+    CFFI_ASSERT(!CffiStructIsVariableSize(structP));
+    if (structP->poolMax == 0)
+        return ckalloc(structP->size);
+
+    if (structP->poolFreeP) {
+        p                  = structP->poolFreeP;
+        structP->poolFreeP = *(void **)p;
+        structP->poolFree -= 1;
+        structP->poolHits += 1;
+    } else {
+        p = ckalloc(CffiStructPoolBlockSize(structP));
+        structP->poolMisses += 1;
+    }
+    /* An existing entry is stale from memory freed outside of cffi */
+    heP = Tcl_CreateHashEntry(&ipCtxP->pooledBlocks, p, &isNew);
+    Tcl_SetHashValue(heP,
+                     (ClientData)(intptr_t)CffiStructPoolBlockSize(structP));
+    return p;
+}
+
+/* Function: CffiStructPoolFree
+ * Frees memory allocated for a struct.
+ *
+ * Parameters:
+ * ipCtxP - interpreter context
+ * structP - struct descriptor
+ * p - memory to free
+ *
+ * The memory is retained in the struct free list if it was a pooled
+ * allocation of the same size and the free list is not at its limit.
+ */
+static void
+CffiStructPoolFree(CffiInterpCtx *ipCtxP, CffiStruct *structP, void *p)
+{
+    Tcl_HashEntry *heP;
+
+    if (ipCtxP->pooledBlocks.numEntries != 0
+        && (heP = Tcl_FindHashEntry(&ipCtxP->pooledBlocks, p)) != NULL) {
+        int size = (int)(intptr_t)Tcl_GetHashValue(heP);
+        Tcl_DeleteHashEntry(heP);
+        if (structP->poolFree < structP->poolMax
+            && size == CffiStructPoolBlockSize(structP)) {
+            *(void **)p        = structP->poolFreeP;
+            structP->poolFreeP = p;
+            structP->poolFree += 1;
+            return;
+        }
+    }
+    ckfree(p);
+}
+
+/* Function: CffiStructPoolForget
+ * Stops tracking memory as a pooled struct allocation.
+ *
+ * Parameters:
+ * ipCtxP - interpreter context
+ * p - memory being freed by the caller
+ *
+ * Must be called when memory that may have been allocated from a struct
+ * pool is freed other than through <CffiStructPoolFree>.
+ */
+void
+CffiStructPoolForget(CffiInterpCtx *ipCtxP, void *p)
+{
+    Tcl_HashEntry *heP;
+
+    if (ipCtxP->pooledBlocks.numEntries != 0
+        && (heP = Tcl_FindHashEntry(&ipCtxP->pooledBlocks, p)) != NULL) {
+        Tcl_DeleteHashEntry(heP);
+    }
+}
+
+/* Function: CffiStructPoolTrim
+ * Releases allocations in a struct free list.
+ *
+ * Parameters:
+ * structP - struct descriptor
+ * maxFree - number of allocations to retain in the free list
+ */
+static void
+CffiStructPoolTrim(CffiStruct *structP, int maxFree)
+{
+    while (structP->poolFree > maxFree) {
+        void *p            = structP->poolFreeP;
+        structP->poolFreeP = *(void **)p;
+        structP->poolFree -= 1;
+        ckfree(p);
+    }
+}
 
 static CffiStruct *CffiStructCkalloc(Tcl_Size nfields)
 {
@@ -20,6 +339,7 @@ static CffiStruct *CffiStructCkalloc(Tcl_Size nfields)
     sz = offsetof(CffiStruct, fields) + (nfields * sizeof(structP->fields[0]));
     structP = ckalloc(sz);
     memset(structP, 0, sz);
+    Tcl_InitHashTable(&structP->fieldIndex, TCL_STRING_KEYS);
     return structP;
 }
 
@@ -49,6 +369,10 @@ CffiStructUnref(CffiStruct *structP)
                 Tcl_DecrRefCount(structP->fields[i].nameObj);
             CffiTypeAndAttrsCleanup(&structP->fields[i].fieldType);
         }
+        Tcl_DeleteHashTable(&structP->fieldIndex);
+        CffiStructPoolTrim(structP, 0);
+        if (structP->flatOpsP)
+            ckfree(structP->flatOpsP);
         ckfree(structP);
     }
     else {
@@ -138,44 +462,33 @@ CffiStructGetDynamicCountNative(CffiInterpCtx *ipCtxP,
     return vlaCount;
 }
 
-/* Function: CffiStructGetDynamicCountFromObj
- * Returns the count from the field storing the size of a VLA in a variable
- * sized struct.
+/* Function: CffiStructGetDynamicCountFromFieldObj
+ * Returns the count from the value of the field storing the size of a VLA
+ * in a variable sized struct.
  *
  * Parameters:
  * ipCtxP - interp context
  * structP - struct descriptor
- * structValueObj - script level struct value
+ * countObj - value of the count field. May be NULL if not present.
  *
  * Returns:
  * The count (> 0) or -1 on error.
  */
 static int
-CffiStructGetDynamicCountFromObj(CffiInterpCtx *ipCtxP,
-                             const CffiStruct *structP,
-                             Tcl_Obj *structValueObj)
+CffiStructGetDynamicCountFromFieldObj(CffiInterpCtx *ipCtxP,
+                                      const CffiStruct *structP,
+                                      Tcl_Obj *countObj)
 {
-    int fldIndex = structP->dynamicCountFieldIndex;
     Tcl_Interp *ip = ipCtxP ? ipCtxP->interp : NULL;
+    int count;
 
-    CFFI_ASSERT(!CffiStructIsUnion(structP));
-    CFFI_ASSERT(structP->dynamicCountFieldIndex >= 0);
-    /* fldIndex can never be last one, already checked in parse */
-    CFFI_ASSERT(fldIndex < structP->nFields - 1);
-
-    if (structValueObj == NULL) {
-        goto unknown_count;
-    }
-    Tcl_Obj *countObj;
-    if (Tcl_DictObjGet(
-            ip, structValueObj, structP->fields[fldIndex].nameObj, &countObj)
-            != TCL_OK) {
-        return -1; /* Invalid dict */
+    if (countObj == NULL) {
+        Tclh_ErrorInvalidValue(
+            ip,
+            structP->fields[structP->dynamicCountFieldIndex].nameObj,
+            "No value supplied for dynamic field count.");
+        return -1;
     }
-    if (countObj == NULL)
-        goto unknown_count; /* Valid dict but no count field value */
-
-    int count;
     if (Tcl_GetIntFromObj(ip, countObj, &count) != TCL_OK)
         return -1;
     if (count < 0) {
@@ -186,12 +499,6 @@ CffiStructGetDynamicCountFromObj(CffiInterpCtx *ipCtxP,
         return -1;
     }
     return count;
-
-unknown_count:
-    Tclh_ErrorInvalidValue(ip,
-                           structP->fields[fldIndex].nameObj,
-                           "No value supplied for dynamic field count.");
-    return -1;
 }
 
 /* Function: CffiStructSizeForVLACount
@@ -286,40 +593,31 @@ CffiStructSizeForVLACount(CffiInterpCtx *ipCtxP,
     return TCL_OK;
 }
 
-/* Function: CffiStructSizeForObj
- * Get the number of bytes needed to store a struct.
+/* Function: CffiStructSizeForFieldObj
+ * Get the number of bytes needed to store a variable sized struct given
+ * the value of the field that determines its size.
  *
  * Parameters:
  * ipCtxP - interp context. Used for error messages. May be NULL.
- * structP - struct descriptor
- * structValueObj - struct value as a dictionary mapping field names to values.
- *   May be NULL for unions and fixed size structs.
+ * structP - struct descriptor. Must be a variable sized struct.
+ * fieldObj - value of the field holding the count of the variable length
+ *   array if the struct has one, or of the last field if that is a
+ *   nested variable sized struct. May be NULL if the field is not present.
  * sizeP - output location to hold size of struct
  * fixedSizeP - output location to hold the fixed size of the struct
- *   i.e. size with vlacount == 0
- *
- * The function takes into account variable sized structs.
+ *   i.e. size with vlacount == 0. May be NULL.
  *
  * Returns:
  * TCL_OK on success, TCL_ERROR on failure.
  * The interp result holds an error message on failure.
  */
-CffiResult
-CffiStructSizeForObj(CffiInterpCtx *ipCtxP,
-                     const CffiStruct *structP,
-                     Tcl_Obj *structValueObj,
-                     int *sizeP,
-                     int *fixedSizeP)
+static CffiResult
+CffiStructSizeForFieldObj(CffiInterpCtx *ipCtxP,
+                          const CffiStruct *structP,
+                          Tcl_Obj *fieldObj,
+                          int *sizeP,
+                          int *fixedSizeP)
 {
-    if (!CffiStructIsVariableSize(structP) || sizeP == NULL
-        || CffiStructIsUnion(structP)) {
-        if (sizeP)
-            *sizeP = structP->size;
-        if (fixedSizeP)
-            *fixedSizeP = structP->size;
-        return TCL_OK;
-    }
-
     int fixedSize = structP->size; /* Should include alignment */
     int size;
 
@@ -345,7 +643,7 @@ CffiStructSizeForObj(CffiInterpCtx *ipCtxP,
         CFFI_ASSERT((fixedSize & (elemAlignment - 1)) == 0);
 
         int count;
-        count = CffiStructGetDynamicCountFromObj(ipCtxP, structP, structValueObj);
+        count = CffiStructGetDynamicCountFromFieldObj(ipCtxP, structP, fieldObj);
         if (count < 0)
             return TCL_ERROR;
 
@@ -354,25 +652,16 @@ CffiStructSizeForObj(CffiInterpCtx *ipCtxP,
         /* Case 2 - recurse to get variable inner struct size and add */
         CFFI_ASSERT(typeP->baseType == CFFI_K_TYPE_STRUCT);
         CffiStruct *innerStructP = typeP->u.structP;
-        Tcl_Obj *innerStructObj;
-        if (Tcl_DictObjGet(ipCtxP->interp,
-                           structValueObj,
-                           structP->fields[lastFldIndex].nameObj,
-                           &innerStructObj)
-            != TCL_OK) {
-            return TCL_ERROR;
-        }
-        if (innerStructObj == NULL) {
-            /* Dict is valid but field not found */
+        if (fieldObj == NULL) {
             return Tclh_ErrorInvalidValue(
-                ipCtxP->interp,
+                ipCtxP ? ipCtxP->interp : NULL,
                 structP->fields[lastFldIndex].nameObj,
                 "No value supplied for variable sized field.");
         }
         int innerFixedSize;
         int innerSize;
         CHECK(CffiStructSizeForObj(
-            ipCtxP, innerStructP, innerStructObj, &innerSize, &innerFixedSize));
+            ipCtxP, innerStructP, fieldObj, &innerSize, &innerFixedSize));
         /* Fixed size should already be aligned to inner struct size */
         CFFI_ASSERT((fixedSize & (innerStructP->alignment - 1)) == 0);
         /*
@@ -384,13 +673,63 @@ CffiStructSizeForObj(CffiInterpCtx *ipCtxP,
     }
     /* Now ensure whole thing aligned to struct size */
     size = (size + structP->alignment - 1) & ~(structP->alignment - 1);
-    if (sizeP)
-        *sizeP = size;
+    *sizeP = size;
     if (fixedSizeP)
         *fixedSizeP = fixedSize;
     return TCL_OK;
 }
 
+/* Function: CffiStructSizeForObj
+ * Get the number of bytes needed to store a struct.
+ *
+ * Parameters:
+ * ipCtxP - interp context. Used for error messages. May be NULL.
+ * structP - struct descriptor
+ * structValueObj - struct value as a dictionary mapping field names to values.
+ *   May be NULL for unions and fixed size structs.
+ * sizeP - output location to hold size of struct
+ * fixedSizeP - output location to hold the fixed size of the struct
+ *   i.e. size with vlacount == 0
+ *
+ * The function takes into account variable sized structs.
+ *
+ * Returns:
+ * TCL_OK on success, TCL_ERROR on failure.
+ * The interp result holds an error message on failure.
+ */
+CffiResult
+CffiStructSizeForObj(CffiInterpCtx *ipCtxP,
+                     const CffiStruct *structP,
+                     Tcl_Obj *structValueObj,
+                     int *sizeP,
+                     int *fixedSizeP)
+{
+    if (!CffiStructIsVariableSize(structP) || sizeP == NULL
+        || CffiStructIsUnion(structP)) {
+        if (sizeP)
+            *sizeP = structP->size;
+        if (fixedSizeP)
+            *fixedSizeP = structP->size;
+        return TCL_OK;
+    }
+
+    /* Only one field, the count or the nested struct, determines size */
+    int fldIndex = structP->dynamicCountFieldIndex >= 0
+                     ? structP->dynamicCountFieldIndex
+                     : structP->nFields - 1;
+    Tcl_Obj *fieldObj = NULL;
+    if (structValueObj
+        && Tcl_DictObjGet(ipCtxP ? ipCtxP->interp : NULL,
+                          structValueObj,
+                          structP->fields[fldIndex].nameObj,
+                          &fieldObj)
+               != TCL_OK) {
+        return TCL_ERROR; /* Invalid dict */
+    }
+    return CffiStructSizeForFieldObj(
+        ipCtxP, structP, fieldObj, sizeP, fixedSizeP);
+}
+
 /* Function: CffiStructSizeForNative
  * Get the number of bytes in a native struct.
  *
@@ -402,7 +741,9 @@ CffiStructSizeForObj(CffiInterpCtx *ipCtxP,
  * fixedSizeP - output location to hold the fixed size of the struct
  *   i.e. size with vlacount == 0
  *
- * The function takes into account variable sized structs.
+ * The function takes into account variable sized structs. The count of
+ * the variable length array is read directly from its offset computed at
+ * definition time, even when it lies in a nested struct.
  *
  * Returns:
  * TCL_OK on success, TCL_ERROR on failure.
@@ -424,95 +765,43 @@ CffiStructSizeForNative(CffiInterpCtx *ipCtxP,
         return TCL_OK;
     }
 
-    int fixedSize = structP->size; /* Should include alignment */
-    int size;
+    CFFI_ASSERT(structP->vlaCountOffset >= 0);
+    int vlaCount = CffiGetCountFromNative(
+        structP->vlaCountOffset + (char *)valueP, structP->vlaCountBaseType);
+    /* CffiStructSizeForVLACount checks vlaCount for validity */
+    return CffiStructSizeForVLACount(
+        ipCtxP, (CffiStruct *)structP, vlaCount, sizeP, fixedSizeP);
+}
 
-    /*
-     * There are two possibilities. The struct is variable size because
-     *  1 the last field is a variable sized array whose
-     *    count is given by another field
-     *  2 the last field is a struct whose last field is variable size
-     *    because of either of these two reasons.
-     * Note that arrays of variable sized structs are not permitted.
-     */
-    int lastFldIndex = structP->nFields - 1;
-    const CffiType *typeP  = &structP->fields[lastFldIndex].fieldType.dataType;
-    CFFI_ASSERT(CffiTypeIsVariableSize(typeP));
-    if (structP->dynamicCountFieldIndex >= 0) {
-        /* Case 1 */
-        CFFI_ASSERT(CffiTypeIsVLA(typeP));
+/* Function: CffiStructComputeFieldAddress
+ * Calculates the offset of a field within a struct in an array of structs.
+ *
+ * Parameters:
+ * ipCtxP - interpreter context
+ * structP - struct descriptor
+ * structAddr - address of the native struct
+ * fldNameObj - name of the field.
+ * fldIndexP - (out) location to hold index of field
+ * fldAddrP - (out) location to hold the address of the field within the struct
+ * fldArraySizeP - (out) number of elements in the field (-1 if scalar)
+ *
+ * Returns:
+ * TCL_OK on success, TCL_ERROR on failure with error message in interpreter
+ */
+static CffiResult
+CffiStructComputeFieldAddress(CffiInterpCtx *ipCtxP,
+                              CffiStruct *structP,
+                              void *structAddr,
+                              Tcl_Obj *fldNameObj,
+                              int *fldIndexP,
+                              void **fldAddrP,
+                              int *fldArraySizeP)
+{
+    Tcl_Interp *ip  = ipCtxP->interp;
 
-        int elemAlignment;
-        int elemSize;
-        CffiTypeLayoutInfo(ipCtxP, typeP, 0, &elemSize, NULL, &elemAlignment);
-        /* Fixed size should already be aligned to element size */
-        CFFI_ASSERT((fixedSize & (elemAlignment - 1)) == 0);
-
-        int count;
-        count = CffiStructGetDynamicCountNative(ipCtxP, structP, valueP);
-        if (count < 0)
-            return TCL_ERROR;
-
-        size = fixedSize + count * elemSize;
-    }
-    else {
-        /* Case 2 - recurse to get variable inner struct size and add */
-        CFFI_ASSERT(typeP->baseType == CFFI_K_TYPE_STRUCT);
-        CffiStruct *innerStructP = typeP->u.structP;
-        void *innerValueP;
-        int innerFixedSize;
-        int innerSize;
-
-        innerValueP = structP->fields[lastFldIndex].offset + (char *)valueP;
-        CHECK(CffiStructSizeForNative(
-            ipCtxP, innerStructP, innerValueP, &innerSize, &innerFixedSize));
-        /* Fixed size should already be aligned to inner struct size */
-        CFFI_ASSERT((fixedSize & (innerStructP->alignment - 1)) == 0);
-        /*
-         * The fixed portion of the inner struct is already included in the
-         * outer struct size as well as in the inner struct fixed size. So
-         * we have to subtract one of these to avoid double counting.
-         */
-        size = fixedSize + innerSize - innerFixedSize;
-    }
-    /* Now ensure whole thing aligned to struct size */
-    size = (size + structP->alignment - 1) & ~(structP->alignment - 1);
-    if (sizeP)
-        *sizeP = size;
-    if (fixedSizeP)
-        *fixedSizeP = fixedSize;
-    return TCL_OK;
-}
-
-/* Function: CffiStructComputeFieldAddress
- * Calculates the offset of a field within a struct in an array of structs.
- *
- * Parameters:
- * ipCtxP - interpreter context
- * structP - struct descriptor
- * structAddr - address of the native struct
- * fldNameObj - name of the field.
- * fldIndexP - (out) location to hold index of field
- * fldAddrP - (out) location to hold the address of the field within the struct
- * fldArraySizeP - (out) number of elements in the field (-1 if scalar)
- *
- * Returns:
- * TCL_OK on success, TCL_ERROR on failure with error message in interpreter
- */
-static CffiResult
-CffiStructComputeFieldAddress(CffiInterpCtx *ipCtxP,
-                              CffiStruct *structP,
-                              void *structAddr,
-                              Tcl_Obj *fldNameObj,
-                              int *fldIndexP,
-                              void **fldAddrP,
-                              int *fldArraySizeP)
-{
-    Tcl_Interp *ip  = ipCtxP->interp;
-
-    int fldIndex = CffiStructFindField(ip, structP, Tcl_GetString(fldNameObj));
-    if (fldIndex < 0)
-        return TCL_ERROR;
+    int fldIndex = CffiStructFindField(ip, structP, fldNameObj);
+    if (fldIndex < 0)
+        return TCL_ERROR;
 
     CffiField *fieldP = &structP->fields[fldIndex];
     int fldArraySize     = fieldP->fieldType.dataType.arraySize;
@@ -732,12 +1021,14 @@ CffiStructParse(CffiInterpCtx *ipCtxP,
 
     structP = CffiStructCkalloc(nfields);
     structP->dynamicCountFieldIndex = -1;
+    structP->vlaCountOffset         = -1;
     structP->structSizeFieldIndex = -1;
     structP->nFields = 0;     /* Update as we go along */
     structP->pack    = pack;
 
     for (i = 0, j = 0; i < nobjs; i += 2, ++j) {
-        int k;
+        Tcl_HashEntry *heP;
+        int isNew;
         if (CffiTypeAndAttrsParse(ipCtxP,
                                   objs[i + 1],
                                   CFFI_F_TYPE_PARSE_FIELD,
@@ -773,18 +1064,19 @@ CffiStructParse(CffiInterpCtx *ipCtxP,
             }
         }
 
-        /* Check for dup field names */
-        for (k = 0; k < j; ++k) {
-            if (!strcmp(Tcl_GetString(objs[i]),
-                        Tcl_GetString(structP->fields[k].nameObj))) {
-                CffiStructUnref(structP);
-                return Tclh_ErrorExists(
-                    ip,
-                    "Field",
-                    objs[i],
-                    "Field names must be unique.");
-            }
+        /* Index field names, checking for duplicates */
+        heP = Tcl_CreateHashEntry(
+            &structP->fieldIndex, Tcl_GetString(objs[i]), &isNew);
+        if (!isNew) {
+            CffiTypeAndAttrsCleanup(&structP->fields[j].fieldType);
+            CffiStructUnref(structP);
+            return Tclh_ErrorExists(
+                ip,
+                "Field",
+                objs[i],
+                "Field names must be unique.");
         }
+        Tcl_SetHashValue(heP, (ClientData)(intptr_t)j);
         Tcl_IncrRefCount(objs[i]);
         structP->fields[j].nameObj = objs[i];
         /* Note: update incrementally for structP cleanup in case of errors */
@@ -859,8 +1151,16 @@ CffiStructParse(CffiInterpCtx *ipCtxP,
                 return TCL_ERROR;
             }
             structP->dynamicCountFieldIndex = countFieldIndex;
+            structP->vlaCountOffset = structP->fields[countFieldIndex].offset;
+            structP->vlaCountBaseType =
+                structP->fields[countFieldIndex].fieldType.dataType.baseType;
         } else {
-            /* Nested variable component. Nought to do */
+            /* Nested variable component. Count is at its offset within it */
+            CffiStruct *innerStructP = lastFldTypeP->u.structP;
+            CFFI_ASSERT(innerStructP->vlaCountOffset >= 0);
+            structP->vlaCountOffset = structP->fields[nfields - 1].offset
+                                    + innerStructP->vlaCountOffset;
+            structP->vlaCountBaseType = innerStructP->vlaCountBaseType;
         }
         /*
          * Mark as variable size - last field is variable size array
@@ -881,36 +1181,86 @@ CffiStructParse(CffiInterpCtx *ipCtxP,
         CFFI_ASSERT((structP->flags & CFFI_F_STRUCT_VARSIZE) == 0);
         structP->flags |= CFFI_F_STRUCT_UNION;
     }
+    if (CffiStructIsPlainData(structP))
+        structP->flags |= CFFI_F_STRUCT_PLAINDATA;
+    else
+        structP->flags |= CFFI_F_STRUCT_NOFLAT;
     *structPP          = structP;
     return TCL_OK;
 }
 
-/* Function: CffiStructFindField
+/* Function: CffiStructFieldIndexFromObj
  * Returns the field index corresponding to a field name
  *
  * Parameters:
- * ip - interpreter. May be NULL if error messages not required.
  * structP - struct descriptor
- * fieldNameP - name of field
+ * fieldNameObj - name of field
+ *
+ * The index is cached in the internal representation of *fieldNameObj*.
+ * Since the same name may be used with different structs, the cached
+ * index is only used if the field at that index has the same name.
  *
  * Returns:
  * Index of field or -1 if not found.
  */
 static int
-CffiStructFindField(Tcl_Interp *ip, CffiStruct *structP, const char *fieldNameP)
+CffiStructFieldIndexFromObj(const CffiStruct *structP, Tcl_Obj *fieldNameObj)
 {
+    Tcl_HashEntry *heP;
+    const char *fieldNameP;
     int i;
-    char message[100];
 
-    for (i = 0; i < structP->nFields; ++i) {
-        if (!strcmp(fieldNameP, Tcl_GetString(structP->fields[i].nameObj)))
+    fieldNameP = Tcl_GetString(fieldNameObj);
+    if (fieldNameObj->typePtr == &cffiFieldIndexObjType) {
+        i = (int)fieldNameObj->internalRep.longValue;
+        if (i < structP->nFields
+            && (structP->fields[i].nameObj == fieldNameObj
+                || !strcmp(fieldNameP,
+                           Tcl_GetString(structP->fields[i].nameObj)))) {
             return i;
+        }
     }
+
+    heP = Tcl_FindHashEntry((Tcl_HashTable *)&structP->fieldIndex,
+                            fieldNameP);
+    if (heP == NULL)
+        return -1;
+
+    i = (int)(intptr_t)Tcl_GetHashValue(heP);
+    /* String rep is retained so no need to invalidate it */
+    if (fieldNameObj->typePtr && fieldNameObj->typePtr->freeIntRepProc)
+        fieldNameObj->typePtr->freeIntRepProc(fieldNameObj);
+    fieldNameObj->internalRep.longValue = i;
+    fieldNameObj->typePtr               = &cffiFieldIndexObjType;
+    return i;
+}
+
+/* Function: CffiStructFindField
+ * Returns the field index corresponding to a field name
+ *
+ * Parameters:
+ * ip - interpreter. May be NULL if error messages not required.
+ * structP - struct descriptor
+ * fieldNameObj - name of field
+ *
+ * Returns:
+ * Index of field or -1 if not found.
+ */
+static int
+CffiStructFindField(Tcl_Interp *ip, CffiStruct *structP, Tcl_Obj *fieldNameObj)
+{
+    char message[100];
+    int i;
+
+    i = CffiStructFieldIndexFromObj(structP, fieldNameObj);
+    if (i >= 0)
+        return i;
+
     snprintf(message,
              sizeof(message),
              "No such field in struct definition %s.",
              Tcl_GetString(structP->name));
-    Tclh_ErrorNotFoundStr(ip, "Field", fieldNameP, message);
+    Tclh_ErrorNotFoundStr(ip, "Field", Tcl_GetString(fieldNameObj), message);
     return -1;
 }
 
@@ -1217,9 +1567,12 @@ CffiStructFromObj(CffiInterpCtx *ipCtxP,
     CffiResult ret;
     void *structAddress;
     int structSize;
-
-    CHECK(CffiStructSizeForObj(
-        ipCtxP, structP, structValueObj, &structSize, NULL));
+    Tcl_Obj *fixedValueObjs[CFFI_K_STRUCT_FIELDS_ON_STACK];
+    Tcl_Obj **valueObjs;
+    Tcl_DictSearch search;
+    Tcl_Obj *keyObj;
+    Tcl_Obj *valueObj;
+    int done;
 
     /*
      * The code later below handles unions as well as a dictionary with
@@ -1231,6 +1584,8 @@ CffiStructFromObj(CffiInterpCtx *ipCtxP,
     if (CffiStructIsUnion(structP)) {
         Tcl_Size len;
         const char *p;
+        CHECK(CffiStructSizeForObj(
+            ipCtxP, structP, structValueObj, &structSize, NULL));
         if ((p = Tclh_ObjGetBytesByRef(ip, structValueObj, &len)) == NULL)
             return TCL_ERROR;
         if (len != structSize) {
@@ -1241,6 +1596,57 @@ CffiStructFromObj(CffiInterpCtx *ipCtxP,
         return TCL_OK;
     }
 
+    /* Values returned from native code of the same struct type are copied */
+    if (structValueObj->typePtr == &cffiStructValueObjType
+        && structValueObj->internalRep.twoPtrValue.ptr1 == structP) {
+        memcpy(structResultP,
+               structValueObj->internalRep.twoPtrValue.ptr2,
+               structP->size);
+        return TCL_OK;
+    }
+
+    /*
+     * Walk the dictionary once, mapping each key to its field. Keys that
+     * are not field names are ignored. A NULL entry in valueObjs marks
+     * a field missing from the dictionary.
+     */
+    if (structP->nFields <= CFFI_K_STRUCT_FIELDS_ON_STACK)
+        valueObjs = fixedValueObjs;
+    else
+        valueObjs = ckalloc(structP->nFields * sizeof(*valueObjs));
+    memset(valueObjs, 0, structP->nFields * sizeof(*valueObjs));
+    if (Tcl_DictObjFirst(
+            ip, structValueObj, &search, &keyObj, &valueObj, &done)
+        != TCL_OK) {
+        ret = TCL_ERROR; /* Invalid dictionary */
+        goto vamoose;
+    }
+    for (; !done; Tcl_DictObjNext(&search, &keyObj, &valueObj, &done)) {
+        int fldIndex = CffiStructFieldIndexFromObj(structP, keyObj);
+        if (fldIndex >= 0)
+            valueObjs[fldIndex] = valueObj;
+    }
+    Tcl_DictObjDone(&search);
+
+    /*
+     * The size of a variable sized struct is only needed for temporary
+     * storage or clearing. Callers have already computed it to allocate
+     * structResultP so avoid doing it again otherwise. When needed, it is
+     * computed from the field values already collected above.
+     */
+    structSize = structP->size;
+    if (CffiStructIsVariableSize(structP)
+        && ((flags & CFFI_F_PRESERVE_ON_ERROR)
+            || (structP->flags & CFFI_F_STRUCT_CLEAR))) {
+        int fldIndex = structP->dynamicCountFieldIndex >= 0
+                         ? structP->dynamicCountFieldIndex
+                         : structP->nFields - 1;
+        ret = CffiStructSizeForFieldObj(
+            ipCtxP, structP, valueObjs[fldIndex], &structSize, NULL);
+        if (ret != TCL_OK)
+            goto vamoose;
+    }
+
     /*
      * If we have to preserve, make a copy. Note we cannot just rely on
      * flags passed to NativeValueFromObj because we are clearing the
@@ -1259,15 +1665,11 @@ CffiStructFromObj(CffiInterpCtx *ipCtxP,
 
     ret = TCL_OK;
     for (i = 0; i < structP->nFields; ++i) {
-        Tcl_Obj *valueObj;
         const CffiField *fieldP = &structP->fields[i];
         void *fieldAddress      = fieldP->offset + (char *)structAddress;
         const CffiTypeAndAttrs *typeAttrsP = &fieldP->fieldType;
 
-        if ((ret =
-                 Tcl_DictObjGet(ip, structValueObj, fieldP->nameObj, &valueObj))
-            != TCL_OK)
-            break; /* Invalid dictionary. Note TCL_OK does not mean found */
+        valueObj = valueObjs[i];
         if (CffiStructIsUnion(structP)) {
             continue; /* Move on to checking for next field */
         }
@@ -1305,8 +1707,8 @@ CffiStructFromObj(CffiInterpCtx *ipCtxP,
         /* The last field may be a variable sized array */
         if (i == (structP->nFields - 1)
             && CffiTypeIsVLA(&fieldP->fieldType.dataType)) {
-            realArraySize =
-                CffiStructGetDynamicCountFromObj(ipCtxP, structP, structValueObj);
+            realArraySize = CffiStructGetDynamicCountFromFieldObj(
+                ipCtxP, structP, valueObjs[structP->dynamicCountFieldIndex]);
             if (realArraySize < 0) {
                 ret = TCL_ERROR;
                 break;
@@ -1358,6 +1760,9 @@ CffiStructFromObj(CffiInterpCtx *ipCtxP,
         }
     }
 
+vamoose:
+    if (valueObjs != fixedValueObjs)
+        ckfree(valueObjs);
     return ret;
 }
 
@@ -1372,6 +1777,8 @@ CffiStructFromObj(CffiInterpCtx *ipCtxP,
  *    Following standard practice, the reference ocunt on the Tcl_Obj is 0.
  *
  * For structs valueObjP will hold a dictionary. For unions, it is a binary.
+ * Plain data structs hold a copy of the native struct and the dictionary
+ * is only generated when the string representation is needed.
  *
  * Returns:
  * *TCL_OK* on success with the wrapper Tcl_Obj pointer stored in valueObjP.
@@ -1383,11 +1790,6 @@ CffiStructToObj(CffiInterpCtx *ipCtxP,
                 void *valueP,
                 Tcl_Obj **valueObjP)
 {
-    int i;
-    Tcl_Obj *valueObj;
-    int ret;
-    Tcl_Interp *ip    = ipCtxP->interp;
-
     /* Unions are always treated as binary as we do not know the field type */
     if (CffiStructIsUnion(structP)) {
         int unionSize;
@@ -1398,6 +1800,239 @@ CffiStructToObj(CffiInterpCtx *ipCtxP,
         return TCL_OK;
     }
 
+    if (structP->flags & CFFI_F_STRUCT_PLAINDATA) {
+        *valueObjP = CffiStructValueNewObj((CffiStruct *)structP, valueP);
+        return TCL_OK;
+    }
+
+    return CffiStructFieldsToObj(ipCtxP, structP, valueP, valueObjP);
+}
+
+/* Function: CffiStructFlattenFields
+ * Appends the operations for converting a struct to a flattened program.
+ *
+ * Parameters:
+ * structP - struct descriptor. Must be a plain data struct.
+ * baseOffset - offset of the struct from the start of the outermost struct
+ * opsP - program being built. Must have room for CFFI_K_STRUCT_FLAT_MAX_OPS
+ *   operations.
+ * nOpsP - location holding number of operations in program. Updated on
+ *   return.
+ *
+ * Arrays of structs are unrolled so the program size grows with the
+ * array sizes.
+ *
+ * Returns:
+ * Non-zero on success, 0 if the program would exceed
+ * CFFI_K_STRUCT_FLAT_MAX_OPS operations.
+ */
+static int
+CffiStructFlattenFields(const CffiStruct *structP,
+                        int baseOffset,
+                        CffiStructFlatOp *opsP,
+                        int *nOpsP)
+{
+    int i, j;
+    int nOps = *nOpsP;
+
+    CFFI_ASSERT(structP->flags & CFFI_F_STRUCT_PLAINDATA);
+    for (i = 0; i < structP->nFields; ++i) {
+        const CffiField *fieldP = &structP->fields[i];
+        const CffiType *typeP   = &fieldP->fieldType.dataType;
+        int offset              = baseOffset + fieldP->offset;
+        if (typeP->baseType == CFFI_K_TYPE_STRUCT) {
+            const CffiStruct *innerP = typeP->u.structP;
+            if (CffiTypeIsNotArray(typeP)) {
+                if (!CffiStructFlattenFields(innerP, offset, opsP, &nOps))
+                    return 0;
+            }
+            else {
+                for (j = 0; j < typeP->arraySize; ++j) {
+                    if (!CffiStructFlattenFields(
+                            innerP, offset + j * innerP->size, opsP, &nOps))
+                        return 0;
+                }
+                if (nOps >= CFFI_K_STRUCT_FLAT_MAX_OPS)
+                    return 0;
+                opsP[nOps].kind  = CFFI_K_FLAT_LIST;
+                opsP[nOps].count = typeP->arraySize;
+                ++nOps;
+            }
+        }
+        else {
+            if (nOps >= CFFI_K_STRUCT_FLAT_MAX_OPS)
+                return 0;
+            opsP[nOps].kind         = CFFI_K_FLAT_LEAF;
+            opsP[nOps].offset       = offset;
+            opsP[nOps].count        = typeP->arraySize;
+            opsP[nOps].u.typeAttrsP = &fieldP->fieldType;
+            ++nOps;
+        }
+    }
+    if (nOps >= CFFI_K_STRUCT_FLAT_MAX_OPS)
+        return 0;
+    opsP[nOps].kind      = CFFI_K_FLAT_DICT;
+    opsP[nOps].u.structP = structP;
+    ++nOps;
+    *nOpsP = nOps;
+    return 1;
+}
+
+/* Function: CffiStructFlatten
+ * Builds the flattened conversion program for a struct if applicable.
+ *
+ * Parameters:
+ * structP - struct descriptor
+ *
+ * Only plain data structs containing nested structs are flattened. For
+ * others there is no recursion to save. The CFFI_F_STRUCT_NOFLAT flag is
+ * set for structs that do not qualify so the check is only done once.
+ *
+ * Returns:
+ * Non-zero if structP->flatOpsP holds the program, else 0.
+ */
+static int
+CffiStructFlatten(CffiStruct *structP)
+{
+    CffiStructFlatOp ops[CFFI_K_STRUCT_FLAT_MAX_OPS];
+    int nOps = 0;
+    int i;
+
+    if (structP->flatOpsP)
+        return 1;
+    if (structP->flags & CFFI_F_STRUCT_NOFLAT)
+        return 0;
+
+    for (i = 0; i < structP->nFields; ++i) {
+        if (structP->fields[i].fieldType.dataType.baseType
+            == CFFI_K_TYPE_STRUCT)
+            break;
+    }
+    if (i == structP->nFields || !CffiStructFlattenFields(structP, 0, ops, &nOps)) {
+        structP->flags |= CFFI_F_STRUCT_NOFLAT;
+        return 0;
+    }
+    structP->flatOpsP = ckalloc(nOps * sizeof(ops[0]));
+    memcpy(structP->flatOpsP, ops, nOps * sizeof(ops[0]));
+    structP->nFlatOps = nOps;
+    return 1;
+}
+
+/* Function: CffiStructFlatToObj
+ * Converts a C structure to a dictionary using its flattened program.
+ *
+ * Parameters:
+ * ipCtxP - interpreter context
+ * structP - struct descriptor whose flattened program has been built
+ * valueP - pointer to C structure to convert
+ * valueObjP - location to store the pointer to the returned Tcl_Obj.
+ *    Following standard practice, the reference count on the Tcl_Obj is 0.
+ *
+ * Nested structs are returned as dictionaries, not native struct values.
+ *
+ * Returns:
+ * *TCL_OK* on success with the dictionary stored in valueObjP.
+ * *TCL_ERROR* on error with message stored in the interpreter.
+ */
+static CffiResult
+CffiStructFlatToObj(CffiInterpCtx *ipCtxP,
+                    const CffiStruct *structP,
+                    void *valueP,
+                    Tcl_Obj **valueObjP)
+{
+    Tcl_Obj *stack[CFFI_K_STRUCT_FLAT_MAX_OPS];
+    Tcl_Obj *elemObjs[2 * CFFI_K_STRUCT_FIELDS_ON_STACK];
+    Tcl_Obj **elemObjsP;
+    Tcl_Obj *fieldObj;
+    int top = 0;
+    int i, j, n;
+
+    CFFI_ASSERT(structP->flatOpsP);
+    for (i = 0; i < structP->nFlatOps; ++i) {
+        const CffiStructFlatOp *opP = &structP->flatOpsP[i];
+        switch (opP->kind) {
+        case CFFI_K_FLAT_LEAF:
+            if (CffiNativeValueToObj(ipCtxP,
+                                     opP->u.typeAttrsP,
+                                     opP->offset + (char *)valueP,
+                                     0,
+                                     opP->count,
+                                     &fieldObj)
+                != TCL_OK) {
+                goto error_return;
+            }
+            stack[top++] = fieldObj;
+            break;
+        case CFFI_K_FLAT_LIST:
+            n = opP->count;
+            CFFI_ASSERT(top >= n);
+            top -= n;
+            stack[top] = Tcl_NewListObj(n, &stack[top]);
+            ++top;
+            break;
+        case CFFI_K_FLAT_DICT:
+            n = opP->u.structP->nFields;
+            CFFI_ASSERT(top >= n);
+            top -= n;
+            if (n <= CFFI_K_STRUCT_FIELDS_ON_STACK)
+                elemObjsP = elemObjs;
+            else
+                elemObjsP = ckalloc(2 * n * sizeof(*elemObjsP));
+            for (j = 0; j < n; ++j) {
+                elemObjsP[2 * j]     = opP->u.structP->fields[j].nameObj;
+                elemObjsP[2 * j + 1] = stack[top + j];
+            }
+            stack[top++] = Tcl_NewListObj(2 * n, elemObjsP);
+            if (elemObjsP != elemObjs)
+                ckfree(elemObjsP);
+            break;
+        }
+    }
+    CFFI_ASSERT(top == 1);
+    *valueObjP = stack[0];
+    return TCL_OK;
+
+error_return:
+    /* Values on the stack have reference count 0 */
+    while (top > 0) {
+        --top;
+        Tcl_IncrRefCount(stack[top]);
+        Tcl_DecrRefCount(stack[top]);
+    }
+    return TCL_ERROR;
+}
+
+/* Function: CffiStructFieldsToObj
+ * Converts a C structure to a dictionary mapping field names to values.
+ *
+ * Parameters:
+ * ipCtxP - interpreter context
+ * structP - pointer to the struct definition internal descriptor. Must
+ *    not be a union.
+ * valueP - pointer to C structure to convert
+ * valueObjP - location to store the pointer to the returned Tcl_Obj.
+ *    Following standard practice, the reference ocunt on the Tcl_Obj is 0.
+ *
+ * Returns:
+ * *TCL_OK* on success with the dictionary stored in valueObjP.
+ * *TCL_ERROR* on error with message stored in the interpreter.
+ */
+static CffiResult
+CffiStructFieldsToObj(CffiInterpCtx *ipCtxP,
+                      const CffiStruct *structP,
+                      void *valueP,
+                      Tcl_Obj **valueObjP)
+{
+    int i;
+    Tcl_Obj *valueObj;
+    int ret;
+    Tcl_Interp *ip    = ipCtxP->interp;
+
+    CFFI_ASSERT(!CffiStructIsUnion(structP));
+
+    if (CffiStructFlatten((CffiStruct *)structP))
+        return CffiStructFlatToObj(ipCtxP, structP, valueP, valueObjP);
+
     valueObj = Tcl_NewListObj(structP->nFields, NULL);
     for (i = 0; i < structP->nFields; ++i) {
         const CffiField *fieldP = &structP->fields[i];
@@ -1568,7 +2203,10 @@ CffiStructAllocateCmd(Tcl_Interp *ip,
     if (count >= TCL_SIZE_MAX/structSize) {
         return Tclh_ErrorAllocation(ip, "Struct", "Array size too large.");
     }
-    resultP = ckalloc(count * structSize);
+    if (count == 1 && !CffiStructIsVariableSize(structP))
+        resultP = CffiStructPoolAlloc(structCtxP->ipCtxP, structP);
+    else
+        resultP = ckalloc(count * structSize);
 
     if (Tclh_PointerRegister(ip,
                              structCtxP->ipCtxP->tclhCtxP,
@@ -1576,7 +2214,7 @@ CffiStructAllocateCmd(Tcl_Interp *ip,
                              structP->name,
                              &resultObj)
         != TCL_OK) {
-        ckfree(resultP);
+        CffiStructPoolFree(structCtxP->ipCtxP, structP, resultP);
         return TCL_ERROR;
     }
     Tcl_SetObjResult(ip, resultObj);
@@ -1617,7 +2255,10 @@ CffiStructNewCmd(Tcl_Interp *ip,
     CHECK(CffiStructSizeForObj(
         ipCtxP, structP, objc == 2 ? NULL : objv[2], &structSize, NULL));
 
-    resultP = ckalloc(structSize);
+    if (CffiStructIsVariableSize(structP))
+        resultP = ckalloc(structSize);
+    else
+        resultP = CffiStructPoolAlloc(ipCtxP, structP);
     if (objc == 3)
         ret = CffiStructFromObj(
             structCtxP->ipCtxP, structP, objv[2], 0, resultP, NULL);
@@ -1635,7 +2276,7 @@ CffiStructNewCmd(Tcl_Interp *ip,
             return TCL_OK;
         }
     }
-    ckfree(resultP);
+    CffiStructPoolFree(ipCtxP, structP, resultP);
     return TCL_ERROR;
 }
 
@@ -2074,87 +2715,918 @@ CffiStructSetNativePointer(Tcl_Interp *ip,
     if (structP->dynamicCountFieldIndex == fldIndex) {
         return CffiErrorStructCountField(ip, objv[3]);
     }
-    if (CffiTypeIsVariableSize(&structP->fields[fldIndex].fieldType.dataType)) {
-        return CffiErrorStructIsVariableSize(ip, structP, "setnative");
+    if (CffiTypeIsVariableSize(&structP->fields[fldIndex].fieldType.dataType)) {
+        return CffiErrorStructIsVariableSize(ip, structP, "setnative");
+    }
+    CHECK(CffiNativeValueFromObj(ipCtxP,
+                                 &structP->fields[fldIndex].fieldType,
+                                 fldArraySize,
+                                 objv[4],
+                                 CFFI_F_PRESERVE_ON_ERROR,
+                                 fldAddr,
+                                 0,
+                                 NULL));
+    return TCL_OK;
+}
+
+/* Function: CffiStructSetNativeCmd
+ * Sets the value of a field in a native struct.
+ *
+ * Parameters:
+ * ipCtxP - interpreter context
+ * objc - number of arguments in objv[]. Caller should have checked for
+ *        total of 5-6 arguments.
+ * objv - argument array. This includes the command and subcommand provided
+ *   at the script level.
+ * structCtxP - pointer to struct context
+ *
+ * The **objv** contains the following arguments:
+ * objv[2] - safe pointer to memory holding the struct value
+ * objv[3] - field name
+ * objv[4] - value to store
+ * objv[5] - optional, index into array of structs pointed to by objv[2]
+ *
+ * Returns:
+ * *TCL_OK* on success with an empty interp result;
+ * *TCL_ERROR* on failure with an error message in the interpreter.
+ */
+static CffiResult
+CffiStructSetNativeCmd(Tcl_Interp *ip,
+                       int objc,
+                       Tcl_Obj *const objv[],
+                       CffiStructCmdCtx *structCtxP)
+{
+    return CffiStructSetNativePointer(ip, objc, objv, structCtxP, 1);
+}
+
+/* Function: CffiStructSetNativeUnsafeCmd
+ * Sets the value of a field in a native struct.
+ *
+ * Parameters:
+ * ipCtxP - interpreter context
+ * objc - number of arguments in objv[]. Caller should have checked for
+ *        total of 5-6 arguments.
+ * objv - argument array. This includes the command and subcommand provided
+ *   at the script level.
+ * structCtxP - safe pointer to struct context
+ *
+ * The **objv** contains the following arguments:
+ * objv[2] - unsafe pointer to memory holding the struct value
+ * objv[3] - field name
+ * objv[4] - value to store
+ * objv[5] - optional, index into array of structs pointed to by objv[2]
+ *
+ * Returns:
+ * *TCL_OK* on success with an empty interp result;
+ * *TCL_ERROR* on failure with an error message in the interpreter.
+ */
+static CffiResult
+CffiStructSetNativeUnsafeCmd(Tcl_Interp *ip,
+                             int objc,
+                             Tcl_Obj *const objv[],
+                             CffiStructCmdCtx *structCtxP)
+{
+    return CffiStructSetNativePointer(ip, objc, objv, structCtxP, 0);
+}
+
+/* Function: CffiStructGetNativeFieldsPointer
+ * Gets the values of multiple fields from a native struct.
+ *
+ * Parameters:
+ * ip - Interpreter
+ * objc - number of arguments in objv[]. Caller should have checked for
+ *        total of 4-5 arguments.
+ * objv - argument array. This includes the command and subcommand provided
+ *   at the script level.
+ * structCtxP - pointer to struct context
+ * safe - if non-0, objv[2] must be a registered pointer
+ *
+ * The **objv** contains the following arguments:
+ * objv[2] - pointer to memory holding the struct value
+ * objv[3] - list of field names
+ * objv[4] - optional, index into array of structs pointed to by objv[2]
+ *
+ * Returns:
+ * *TCL_OK* on success with an empty interp result;
+ * *TCL_ERROR* on failure with an error message in the interpreter.
+ */
+static CffiResult
+CffiStructGetNativeFieldsPointer(Tcl_Interp *ip,
+                                 int objc,
+                                 Tcl_Obj *const objv[],
+                                 CffiStructCmdCtx *structCtxP,
+                                 int safe)
+{
+    CffiStruct *structP = structCtxP->structP;
+    CffiInterpCtx *ipCtxP = structCtxP->ipCtxP;
+    void *structAddr;
+    Tcl_Size nNames;
+    int ret;
+
+    /* S fieldpointer POINTER FIELDNAMES ?INDEX? */
+    CFFI_ASSERT(objc >= 4);
+
+    CHECK(CffiStructComputeAddress(structCtxP->ipCtxP,
+                                   structP,
+                                   objv[2],
+                                   safe,
+                                   objc > 4 ? objv[4] : NULL,
+                                   &structAddr));
+
+    /*
+     * Just a little note here about not using Tcl_ListObjGetElements
+     * here - the fear is that it may shimmer in one of the calls.
+     * To guard against that we would need to call Tcl_DuplicateObj.
+     * That is slower than the below approach since number of fields
+     * is likely quite small.
+     */
+    ret = Tcl_ListObjLength(ip, objv[3], &nNames);
+    if (ret == TCL_OK) {
+        Tcl_Obj *valueObj;
+        Tcl_Obj *valuesObj;
+        int i;
+        valuesObj = Tcl_NewListObj(nNames, NULL);
+        for (i = 0; ret == TCL_OK && i < nNames; ++i) {
+            Tcl_Obj *nameObj;
+            int fldIndex;
+            void *fldAddr;
+            int fldArraySize;
+            Tcl_ListObjIndex(NULL, objv[3], i, &nameObj);
+            Tcl_IncrRefCount(nameObj);
+            ret = CffiStructComputeFieldAddress(ipCtxP,
+                                                structP,
+                                                structAddr,
+                                                nameObj,
+                                                &fldIndex,
+                                                &fldAddr,
+                                                &fldArraySize);
+            Tcl_DecrRefCount(nameObj);
+            if (ret == TCL_OK) {
+                ret = CffiNativeValueToObj(ipCtxP,
+                                           &structP->fields[fldIndex].fieldType,
+                                           fldAddr,
+                                           0,
+                                           fldArraySize,
+                                           &valueObj);
+                if (ret == TCL_OK) {
+                    Tcl_ListObjAppendElement(NULL, valuesObj, valueObj);
+                }
+            }
+        }
+        if (ret == TCL_OK)
+            Tcl_SetObjResult(ip, valuesObj);
+        else
+            Tcl_DecrRefCount(valuesObj);
+    }
+    return ret;
+}
+
+/* Function: CffiStructGetNativeFieldsCmd
+ * Gets the values of multiple fields from a native struct.
+ *
+ * Parameters:
+ * ip - Interpreter
+ * objc - number of arguments in objv[]. Caller should have checked for
+ *        total of 4-5 arguments.
+ * objv - argument array. This includes the command and subcommand provided
+ *   at the script level.
+ * structCtxP - pointer to struct context
+ *
+ * The **objv** contains the following arguments:
+ * objv[2] - safe pointer to memory holding the struct value
+ * objv[3] - list of field names
+ * objv[4] - optional, index into array of structs pointed to by objv[2]
+ *
+ * Returns:
+ * *TCL_OK* on success with an empty interp result;
+ * *TCL_ERROR* on failure with an error message in the interpreter.
+ */
+static CffiResult
+CffiStructGetNativeFieldsCmd(Tcl_Interp *ip,
+                             int objc,
+                             Tcl_Obj *const objv[],
+                             CffiStructCmdCtx *structCtxP)
+{
+    return CffiStructGetNativeFieldsPointer(ip, objc, objv, structCtxP, 1);
+}
+
+/* Function: CffiStructGetNativeFieldsUnsafeCmd
+ * Gets the values of multiple fields from a native struct.
+ *
+ * Parameters:
+ * ip - Interpreter
+ * objc - number of arguments in objv[]. Caller should have checked for
+ *        total of 4-5 arguments.
+ * objv - argument array. This includes the command and subcommand provided
+ *   at the script level.
+ * structCtxP - pointer to struct context
+ *
+ * The **objv** contains the following arguments:
+ * objv[2] - unsafe pointer to memory holding the struct value
+ * objv[3] - list of field names
+ * objv[4] - optional, index into array of structs pointed to by objv[2]
+ *
+ * Returns:
+ * *TCL_OK* on success with an empty interp result;
+ * *TCL_ERROR* on failure with an error message in the interpreter.
+ */
+static CffiResult
+CffiStructGetNativeFieldsUnsafeCmd(Tcl_Interp *ip,
+                                   int objc,
+                                   Tcl_Obj *const objv[],
+                                   CffiStructCmdCtx *structCtxP)
+{
+    return CffiStructGetNativeFieldsPointer(ip, objc, objv, structCtxP, 0);
+}
+
+/* Function: CffiStructFieldIndicesFromObj
+ * Resolves a list of field names to field indices.
+ *
+ * Parameters:
+ * ipCtxP - interpreter context
+ * structP - struct descriptor
+ * namesObj - list of field names. If NULL, all fields are returned
+ *   in definition order.
+ * nFieldsP - location to store number of fields
+ * fldIndicesP - location to store array of field indices. This is
+ *   allocated from the interpreter memlifo and must be freed by the caller
+ *   by popping the memlifo.
+ *
+ * Returns:
+ * TCL_OK on success, TCL_ERROR on failure with error message in interpreter
+ */
+static CffiResult
+CffiStructFieldIndicesFromObj(CffiInterpCtx *ipCtxP,
+                              CffiStruct *structP,
+                              Tcl_Obj *namesObj,
+                              Tcl_Size *nFieldsP,
+                              int **fldIndicesP)
+{
+    Tcl_Obj **nameObjs;
+    Tcl_Size nNames;
+    int *fldIndices;
+    int i;
+
+    if (namesObj == NULL) {
+        nNames     = structP->nFields;
+        fldIndices = Tclh_LifoAlloc(&ipCtxP->memlifo, nNames * sizeof(int));
+        for (i = 0; i < nNames; ++i)
+            fldIndices[i] = i;
+    } else {
+        /* Field name lookups do not shimmer the list itself */
+        CHECK(Tcl_ListObjGetElements(
+            ipCtxP->interp, namesObj, &nNames, &nameObjs));
+        fldIndices = Tclh_LifoAlloc(&ipCtxP->memlifo,
+                                    (nNames ? nNames : 1) * sizeof(int));
+        for (i = 0; i < nNames; ++i) {
+            fldIndices[i] =
+                CffiStructFindField(ipCtxP->interp, structP, nameObjs[i]);
+            if (fldIndices[i] < 0)
+                return TCL_ERROR;
+        }
+    }
+    *nFieldsP    = nNames;
+    *fldIndicesP = fldIndices;
+    return TCL_OK;
+}
+
+/* Function: CffiStructToColumnsPointer
+ * Gets the values of fields from an array of native structs as one list
+ * per field.
+ *
+ * Parameters:
+ * ip - Interpreter
+ * objc - number of arguments in objv[]. Caller should have checked for
+ *        total of 4-5 arguments.
+ * objv - argument array. This includes the command and subcommand provided
+ *   at the script level.
+ * structCtxP - pointer to struct context
+ * safe - if non-0, objv[2] must be a registered pointer
+ *
+ * The **objv** contains the following arguments:
+ * objv[2] - pointer to memory holding the array of structs
+ * objv[3] - number of structs in the array
+ * objv[4] - optional, list of field names. Defaults to all fields.
+ *
+ * Returns:
+ * *TCL_OK* on success with the list of field value lists in the interpreter
+ * result;
+ * *TCL_ERROR* on failure with an error message in the interpreter.
+ */
+static CffiResult
+CffiStructToColumnsPointer(Tcl_Interp *ip,
+                           int objc,
+                           Tcl_Obj *const objv[],
+                           CffiStructCmdCtx *structCtxP,
+                           int safe)
+{
+    CffiStruct *structP   = structCtxP->structP;
+    CffiInterpCtx *ipCtxP = structCtxP->ipCtxP;
+    void *structAddr;
+    Tcl_Obj **elemObjs;
+    Tcl_Obj *resultObj;
+    Tclh_LifoMark mark;
+    Tcl_WideInt wide;
+    Tcl_Size nFields;
+    int *fldIndices;
+    int count;
+    int i, j;
+    CffiResult ret;
+
+    /* S tocolumns POINTER COUNT ?FIELDNAMES? */
+    CFFI_ASSERT(objc >= 4);
+
+    if (CffiStructIsVariableSize(structP))
+        return CffiErrorStructIsVariableSize(ip, structP, "tocolumns");
+    CHECK(CffiStructComputeAddress(
+        ipCtxP, structP, objv[2], safe, NULL, &structAddr));
+    CHECK(Tclh_ObjToRangedInt(ip, objv[3], 0, INT_MAX, &wide));
+    count = (int)wide;
+
+    mark = Tclh_LifoPushMark(&ipCtxP->memlifo);
+    ret  = CffiStructFieldIndicesFromObj(
+        ipCtxP, structP, objc > 4 ? objv[4] : NULL, &nFields, &fldIndices);
+    if (ret != TCL_OK)
+        goto vamoose;
+
+    elemObjs = Tclh_LifoAlloc(&ipCtxP->memlifo,
+                              (count ? count : 1) * sizeof(*elemObjs));
+    resultObj = Tcl_NewListObj(0, NULL);
+    for (i = 0; i < nFields; ++i) {
+        const CffiField *fieldP = &structP->fields[fldIndices[i]];
+        char *fldAddr           = fieldP->offset + (char *)structAddr;
+        int fldArraySize        = fieldP->fieldType.dataType.arraySize;
+        for (j = 0; j < count; ++j, fldAddr += structP->size) {
+            ret = CffiNativeValueToObj(ipCtxP,
+                                       &fieldP->fieldType,
+                                       fldAddr,
+                                       0,
+                                       fldArraySize,
+                                       &elemObjs[j]);
+            if (ret != TCL_OK) {
+                while (j--)
+                    Tcl_DecrRefCount(elemObjs[j]);
+                Tcl_DecrRefCount(resultObj);
+                goto vamoose;
+            }
+        }
+        Tcl_ListObjAppendElement(
+            NULL, resultObj, Tcl_NewListObj(count, elemObjs));
+    }
+    Tcl_SetObjResult(ip, resultObj);
+
+vamoose:
+    Tclh_LifoPopMark(mark);
+    return ret;
+}
+
+/* Function: CffiStructToColumnsCmd
+ * Gets the values of fields from an array of native structs as one list
+ * per field.
+ *
+ * Parameters:
+ * ip - Interpreter
+ * objc - number of arguments in objv[]. Caller should have checked for
+ *        total of 4-5 arguments.
+ * objv - argument array. This includes the command and subcommand provided
+ *   at the script level.
+ * structCtxP - pointer to struct context
+ *
+ * The **objv** contains the following arguments:
+ * objv[2] - safe pointer to memory holding the array of structs
+ * objv[3] - number of structs in the array
+ * objv[4] - optional, list of field names. Defaults to all fields.
+ *
+ * Returns:
+ * *TCL_OK* on success with the list of field value lists in the interpreter
+ * result;
+ * *TCL_ERROR* on failure with an error message in the interpreter.
+ */
+static CffiResult
+CffiStructToColumnsCmd(Tcl_Interp *ip,
+                       int objc,
+                       Tcl_Obj *const objv[],
+                       CffiStructCmdCtx *structCtxP)
+{
+    return CffiStructToColumnsPointer(ip, objc, objv, structCtxP, 1);
+}
+
+/* Function: CffiStructToColumnsUnsafeCmd
+ * Gets the values of fields from an array of native structs as one list
+ * per field.
+ *
+ * Parameters:
+ * ip - Interpreter
+ * objc - number of arguments in objv[]. Caller should have checked for
+ *        total of 4-5 arguments.
+ * objv - argument array. This includes the command and subcommand provided
+ *   at the script level.
+ * structCtxP - pointer to struct context
+ *
+ * The **objv** contains the following arguments:
+ * objv[2] - unsafe pointer to memory holding the array of structs
+ * objv[3] - number of structs in the array
+ * objv[4] - optional, list of field names. Defaults to all fields.
+ *
+ * Returns:
+ * *TCL_OK* on success with the list of field value lists in the interpreter
+ * result;
+ * *TCL_ERROR* on failure with an error message in the interpreter.
+ */
+static CffiResult
+CffiStructToColumnsUnsafeCmd(Tcl_Interp *ip,
+                             int objc,
+                             Tcl_Obj *const objv[],
+                             CffiStructCmdCtx *structCtxP)
+{
+    return CffiStructToColumnsPointer(ip, objc, objv, structCtxP, 0);
+}
+
+/* Function: CffiStructFromColumnsPointer
+ * Sets the values of fields in an array of native structs from one list
+ * per field.
+ *
+ * Parameters:
+ * ip - Interpreter
+ * objc - number of arguments in objv[]. Caller should have checked for
+ *        total of 4-5 arguments.
+ * objv - argument array. This includes the command and subcommand provided
+ *   at the script level.
+ * structCtxP - pointer to struct context
+ * safe - if non-0, objv[2] must be a registered pointer
+ *
+ * The **objv** contains the following arguments:
+ * objv[2] - pointer to memory holding the array of structs
+ * objv[3] - list of field value lists, all of the same length
+ * objv[4] - optional, list of field names. Defaults to all fields.
+ *
+ * The lengths of all value lists are checked before memory is modified.
+ * On a conversion error, elements preceding the failing one may have been
+ * modified.
+ *
+ * Returns:
+ * *TCL_OK* on success with an empty interp result;
+ * *TCL_ERROR* on failure with an error message in the interpreter.
+ */
+static CffiResult
+CffiStructFromColumnsPointer(Tcl_Interp *ip,
+                             int objc,
+                             Tcl_Obj *const objv[],
+                             CffiStructCmdCtx *structCtxP,
+                             int safe)
+{
+    CffiStruct *structP   = structCtxP->structP;
+    CffiInterpCtx *ipCtxP = structCtxP->ipCtxP;
+    void *structAddr;
+    Tcl_Obj *columnObj;
+    Tcl_Obj **valueObjs;
+    Tclh_LifoMark mark;
+    Tcl_Size nFields;
+    Tcl_Size nColumns;
+    Tcl_Size count;
+    Tcl_Size len;
+    int *fldIndices;
+    int i, j;
+    CffiResult ret;
+
+    /* S fromcolumns POINTER COLUMNS ?FIELDNAMES? */
+    CFFI_ASSERT(objc >= 4);
+
+    if (CffiStructIsVariableSize(structP))
+        return CffiErrorStructIsVariableSize(ip, structP, "fromcolumns");
+    CHECK(CffiStructComputeAddress(
+        ipCtxP, structP, objv[2], safe, NULL, &structAddr));
+
+    mark = Tclh_LifoPushMark(&ipCtxP->memlifo);
+    ret  = CffiStructFieldIndicesFromObj(
+        ipCtxP, structP, objc > 4 ? objv[4] : NULL, &nFields, &fldIndices);
+    if (ret != TCL_OK)
+        goto vamoose;
+
+    /*
+     * Validate all columns before writing any memory. Columns are
+     * retrieved by index each time as value conversion may shimmer
+     * elements shared between lists.
+     */
+    ret = Tcl_ListObjLength(ip, objv[3], &nColumns);
+    if (ret != TCL_OK)
+        goto vamoose;
+    if (nColumns != nFields) {
+        ret = Tclh_ErrorInvalidValue(
+            ip, NULL, "Number of value lists does not match number of fields.");
+        goto vamoose;
+    }
+    count = 0;
+    for (i = 0; i < nColumns; ++i) {
+        Tcl_ListObjIndex(NULL, objv[3], i, &columnObj);
+        ret = Tcl_ListObjLength(ip, columnObj, &len);
+        if (ret != TCL_OK)
+            goto vamoose;
+        if (i == 0)
+            count = len;
+        else if (len != count) {
+            ret = Tclh_ErrorInvalidValue(
+                ip, NULL, "Field value lists differ in length.");
+            goto vamoose;
+        }
+    }
+
+    for (i = 0; i < nColumns; ++i) {
+        const CffiField *fieldP = &structP->fields[fldIndices[i]];
+        char *fldAddr           = fieldP->offset + (char *)structAddr;
+        int fldArraySize        = fieldP->fieldType.dataType.arraySize;
+
+        Tcl_ListObjIndex(NULL, objv[3], i, &columnObj);
+        Tcl_ListObjGetElements(NULL, columnObj, &len, &valueObjs);
+        CFFI_ASSERT(len == count);
+        for (j = 0; j < count; ++j, fldAddr += structP->size) {
+            ret = CffiNativeValueFromObj(ipCtxP,
+                                         &fieldP->fieldType,
+                                         fldArraySize,
+                                         valueObjs[j],
+                                         CFFI_F_PRESERVE_ON_ERROR,
+                                         fldAddr,
+                                         0,
+                                         NULL);
+            if (ret != TCL_OK) {
+                Tcl_AppendResult(ip,
+                                 " Error converting field ",
+                                 Tcl_GetString(structP->name),
+                                 ".",
+                                 Tcl_GetString(fieldP->nameObj),
+                                 " to a native value.",
+                                 NULL);
+                goto vamoose;
+            }
+        }
+    }
+
+vamoose:
+    Tclh_LifoPopMark(mark);
+    return ret;
+}
+
+/* Function: CffiStructFromColumnsCmd
+ * Sets the values of fields in an array of native structs from one list
+ * per field.
+ *
+ * Parameters:
+ * ip - Interpreter
+ * objc - number of arguments in objv[]. Caller should have checked for
+ *        total of 4-5 arguments.
+ * objv - argument array. This includes the command and subcommand provided
+ *   at the script level.
+ * structCtxP - pointer to struct context
+ *
+ * The **objv** contains the following arguments:
+ * objv[2] - safe pointer to memory holding the array of structs
+ * objv[3] - list of field value lists, all of the same length
+ * objv[4] - optional, list of field names. Defaults to all fields.
+ *
+ * Returns:
+ * *TCL_OK* on success with an empty interp result;
+ * *TCL_ERROR* on failure with an error message in the interpreter.
+ */
+static CffiResult
+CffiStructFromColumnsCmd(Tcl_Interp *ip,
+                         int objc,
+                         Tcl_Obj *const objv[],
+                         CffiStructCmdCtx *structCtxP)
+{
+    return CffiStructFromColumnsPointer(ip, objc, objv, structCtxP, 1);
+}
+
+/* Function: CffiStructFromColumnsUnsafeCmd
+ * Sets the values of fields in an array of native structs from one list
+ * per field.
+ *
+ * Parameters:
+ * ip - Interpreter
+ * objc - number of arguments in objv[]. Caller should have checked for
+ *        total of 4-5 arguments.
+ * objv - argument array. This includes the command and subcommand provided
+ *   at the script level.
+ * structCtxP - pointer to struct context
+ *
+ * The **objv** contains the following arguments:
+ * objv[2] - unsafe pointer to memory holding the array of structs
+ * objv[3] - list of field value lists, all of the same length
+ * objv[4] - optional, list of field names. Defaults to all fields.
+ *
+ * Returns:
+ * *TCL_OK* on success with an empty interp result;
+ * *TCL_ERROR* on failure with an error message in the interpreter.
+ */
+static CffiResult
+CffiStructFromColumnsUnsafeCmd(Tcl_Interp *ip,
+                               int objc,
+                               Tcl_Obj *const objv[],
+                               CffiStructCmdCtx *structCtxP)
+{
+    return CffiStructFromColumnsPointer(ip, objc, objv, structCtxP, 0);
+}
+
+/* Function: CffiStructAccessorInstanceCmd
+ * Implements the command for accessing a single field of a native struct.
+ *
+ * Parameters:
+ * cdata - the accessor context
+ * ip - interpreter
+ * objc - number of elements in *objv*
+ * objv - array containing the command, pointer and optional value
+ *
+ * If a value is supplied, it is stored in the field. Otherwise the current
+ * value of the field is returned.
+ *
+ * Returns:
+ * *TCL_OK* on success with the field value or empty interp result;
+ * *TCL_ERROR* on failure with an error message in the interpreter.
+ */
+static CffiResult
+CffiStructAccessorInstanceCmd(ClientData cdata,
+                              Tcl_Interp *ip,
+                              int objc,
+                              Tcl_Obj *const objv[])
+{
+    CffiStructAccessor *accessorP = (CffiStructAccessor *)cdata;
+    CffiInterpCtx *ipCtxP         = accessorP->ipCtxP;
+    CffiStruct *structP           = accessorP->structP;
+    const CffiField *fieldP       = &structP->fields[accessorP->fldIndex];
+    int fldArraySize              = fieldP->fieldType.dataType.arraySize;
+    void *structAddr;
+    void *fldAddr;
+    Tcl_Obj *valueObj;
+
+    if (objc < 2 || objc > 3) {
+        Tcl_WrongNumArgs(ip, 1, objv, "POINTER ?VALUE?");
+        return TCL_ERROR;
+    }
+
+    CHECK(CffiStructComputeAddress(
+        ipCtxP, structP, objv[1], accessorP->safe, NULL, &structAddr));
+    fldAddr = fieldP->offset + (char *)structAddr;
+
+    if (objc == 2) {
+        if (CffiTypeIsVLA(&fieldP->fieldType.dataType)) {
+            fldArraySize =
+                CffiStructGetDynamicCountNative(ipCtxP, structP, structAddr);
+            if (fldArraySize < 0)
+                return TCL_ERROR;
+        }
+        CHECK(CffiNativeValueToObj(ipCtxP,
+                                   &fieldP->fieldType,
+                                   fldAddr,
+                                   0,
+                                   fldArraySize,
+                                   &valueObj));
+        Tcl_SetObjResult(ip, valueObj);
+        return TCL_OK;
     }
-    CHECK(CffiNativeValueFromObj(ipCtxP,
-                                 &structP->fields[fldIndex].fieldType,
-                                 fldArraySize,
-                                 objv[4],
-                                 CFFI_F_PRESERVE_ON_ERROR,
-                                 fldAddr,
-                                 0,
-                                 NULL));
-    return TCL_OK;
+
+    /* Same restrictions as setnative */
+    if (structP->dynamicCountFieldIndex == accessorP->fldIndex)
+        return CffiErrorStructCountField(ip, fieldP->nameObj);
+    if (CffiTypeIsVariableSize(&fieldP->fieldType.dataType)) {
+        return CffiErrorStructIsVariableSize(
+            ip, structP, Tcl_GetString(objv[0]));
+    }
+    return CffiNativeValueFromObj(ipCtxP,
+                                  &fieldP->fieldType,
+                                  fldArraySize,
+                                  objv[2],
+                                  CFFI_F_PRESERVE_ON_ERROR,
+                                  fldAddr,
+                                  0,
+                                  NULL);
 }
 
-/* Function: CffiStructSetNativeCmd
- * Sets the value of a field in a native struct.
+static void
+CffiStructAccessorDeleter(ClientData cdata)
+{
+    CffiStructAccessor *accessorP = (CffiStructAccessor *)cdata;
+    CffiStructUnref(accessorP->structP);
+    ckfree(accessorP);
+}
+
+/* Function: CffiStructAccessorCmd
+ * Creates a command for accessing a single field of a native struct.
  *
  * Parameters:
- * ipCtxP - interpreter context
+ * ip - Interpreter
  * objc - number of arguments in objv[]. Caller should have checked for
- *        total of 5-6 arguments.
+ *        total of 4-5 arguments.
  * objv - argument array. This includes the command and subcommand provided
  *   at the script level.
  * structCtxP - pointer to struct context
  *
  * The **objv** contains the following arguments:
- * objv[2] - safe pointer to memory holding the struct value
+ * objv[2] - name of the command to create
  * objv[3] - field name
- * objv[4] - value to store
- * objv[5] - optional, index into array of structs pointed to by objv[2]
+ * objv[4] - optional, *-unsafe* if the command should accept unsafe pointers
+ *
+ * The field is resolved when the command is created so invocations of the
+ * command only need to validate the pointer.
  *
  * Returns:
- * *TCL_OK* on success with an empty interp result;
+ * *TCL_OK* on success with the fully qualified command name as interp result;
  * *TCL_ERROR* on failure with an error message in the interpreter.
  */
 static CffiResult
-CffiStructSetNativeCmd(Tcl_Interp *ip,
-                       int objc,
-                       Tcl_Obj *const objv[],
-                       CffiStructCmdCtx *structCtxP)
+CffiStructAccessorCmd(Tcl_Interp *ip,
+                      int objc,
+                      Tcl_Obj *const objv[],
+                      CffiStructCmdCtx *structCtxP)
 {
-    return CffiStructSetNativePointer(ip, objc, objv, structCtxP, 1);
+    static const char *const options[] = {"-unsafe", NULL};
+    CffiStruct *structP = structCtxP->structP;
+    CffiStructAccessor *accessorP;
+    Tcl_Obj *cmdNameObj;
+    int fldIndex;
+    int opt;
+
+    /* S accessor CMDNAME FIELD ?-unsafe? */
+    CFFI_ASSERT(objc >= 4);
+
+    if (objc > 4)
+        CHECK(Tcl_GetIndexFromObj(ip, objv[4], options, "option", 0, &opt));
+    fldIndex = CffiStructFindField(ip, structP, objv[3]);
+    if (fldIndex < 0)
+        return TCL_ERROR;
+
+    accessorP           = ckalloc(sizeof(*accessorP));
+    accessorP->ipCtxP   = structCtxP->ipCtxP;
+    accessorP->structP  = structP;
+    accessorP->fldIndex = fldIndex;
+    accessorP->safe     = objc == 4;
+    CffiStructRef(structP);
+
+    cmdNameObj = Tclh_NsQualifyNameObj(ip, objv[2], NULL);
+    Tcl_IncrRefCount(cmdNameObj);
+    Tcl_CreateObjCommand(ip,
+                         Tcl_GetString(cmdNameObj),
+                         CffiStructAccessorInstanceCmd,
+                         accessorP,
+                         CffiStructAccessorDeleter);
+    Tcl_SetObjResult(ip, cmdNameObj);
+    Tcl_DecrRefCount(cmdNameObj);
+    return TCL_OK;
 }
 
-/* Function: CffiStructSetNativeUnsafeCmd
- * Sets the value of a field in a native struct.
+/* Function: CffiStructViewInstanceCmd
+ * Implements the command for a view bound to a native struct.
  *
  * Parameters:
- * ipCtxP - interpreter context
- * objc - number of arguments in objv[]. Caller should have checked for
- *        total of 5-6 arguments.
- * objv - argument array. This includes the command and subcommand provided
- *   at the script level.
- * structCtxP - safe pointer to struct context
+ * cdata - the view context
+ * ip - interpreter
+ * objc - number of elements in *objv*
+ * objv - VIEW SUBCOMMAND ?ARG ...?
  *
- * The **objv** contains the following arguments:
- * objv[2] - unsafe pointer to memory holding the struct value
- * objv[3] - field name
- * objv[4] - value to store
- * objv[5] - optional, index into array of structs pointed to by objv[2]
+ * The pointer is parsed and its tag and registration checked when the view
+ * is created, not on every call. Safe views are instead invalidated by
+ * <CffiPointerWatchesInvalidate> when the pointer is disposed of.
  *
  * Returns:
- * *TCL_OK* on success with an empty interp result;
+ * *TCL_OK* on success with result in interpreter;
  * *TCL_ERROR* on failure with an error message in the interpreter.
  */
 static CffiResult
-CffiStructSetNativeUnsafeCmd(Tcl_Interp *ip,
-                             int objc,
-                             Tcl_Obj *const objv[],
-                             CffiStructCmdCtx *structCtxP)
+CffiStructViewInstanceCmd(ClientData cdata,
+                          Tcl_Interp *ip,
+                          int objc,
+                          Tcl_Obj *const objv[])
 {
-    return CffiStructSetNativePointer(ip, objc, objv, structCtxP, 0);
+    CffiStructView *viewP = (CffiStructView *)cdata;
+    CffiInterpCtx *ipCtxP = viewP->ipCtxP;
+    CffiStruct *structP   = viewP->structP;
+    enum cmds { DESTROY, FIELDS, GET, SET };
+    static const Tclh_SubCommand subCommands[] = {
+        {"destroy", 0, 0, "", NULL},
+        {"fields", 0, 1, "?FIELDNAMES?", NULL},
+        {"get", 1, 1, "FIELD", NULL},
+        {"set", 2, 2, "FIELD VALUE", NULL},
+        {NULL}};
+    Tcl_Obj *valueObj;
+    Tcl_Obj *valuesObj;
+    Tclh_LifoMark mark;
+    void *fldAddr;
+    int fldArraySize;
+    int fldIndex;
+    Tcl_Size nFields;
+    int *fldIndices;
+    int cmdIndex;
+    int i;
+    CffiResult ret;
+
+    CHECK(Tclh_SubCommandLookup(ip, subCommands, objc, objv, &cmdIndex));
+    if (cmdIndex == DESTROY) {
+        Tcl_DeleteCommandFromToken(ip, Tcl_GetCommandFromObj(ip, objv[0]));
+        return TCL_OK;
+    }
+    if (viewP->safe && viewP->watch.disposed) {
+        return Tclh_ErrorGeneric(
+            ip, NULL, "The pointer bound to the view has been disposed of.");
+    }
+
+    switch (cmdIndex) {
+    case FIELDS:
+        mark = Tclh_LifoPushMark(&ipCtxP->memlifo);
+        ret  = CffiStructFieldIndicesFromObj(ipCtxP,
+                                            structP,
+                                            objc > 2 ? objv[2] : NULL,
+                                            &nFields,
+                                            &fldIndices);
+        if (ret == TCL_OK) {
+            valuesObj = Tcl_NewListObj(nFields, NULL);
+            for (i = 0; i < nFields; ++i) {
+                CffiField *fieldP = &structP->fields[fldIndices[i]];
+                fldArraySize      = fieldP->fieldType.dataType.arraySize;
+                if (CffiTypeIsVLA(&fieldP->fieldType.dataType)) {
+                    fldArraySize = CffiStructGetDynamicCountNative(
+                        ipCtxP, structP, viewP->structAddr);
+                    if (fldArraySize < 0) {
+                        ret = TCL_ERROR;
+                        break;
+                    }
+                }
+                ret = CffiNativeValueToObj(ipCtxP,
+                                           &fieldP->fieldType,
+                                           fieldP->offset
+                                               + (char *)viewP->structAddr,
+                                           0,
+                                           fldArraySize,
+                                           &valueObj);
+                if (ret != TCL_OK)
+                    break;
+                Tcl_ListObjAppendElement(NULL, valuesObj, valueObj);
+            }
+            if (ret == TCL_OK)
+                Tcl_SetObjResult(ip, valuesObj);
+            else
+                Tcl_DecrRefCount(valuesObj);
+        }
+        Tclh_LifoPopMark(mark);
+        return ret;
+
+    case GET:
+        CHECK(CffiStructComputeFieldAddress(ipCtxP,
+                                            structP,
+                                            viewP->structAddr,
+                                            objv[2],
+                                            &fldIndex,
+                                            &fldAddr,
+                                            &fldArraySize));
+        CHECK(CffiNativeValueToObj(ipCtxP,
+                                   &structP->fields[fldIndex].fieldType,
+                                   fldAddr,
+                                   0,
+                                   fldArraySize,
+                                   &valueObj));
+        Tcl_SetObjResult(ip, valueObj);
+        return TCL_OK;
+
+    case SET:
+        CHECK(CffiStructComputeFieldAddress(ipCtxP,
+                                            structP,
+                                            viewP->structAddr,
+                                            objv[2],
+                                            &fldIndex,
+                                            &fldAddr,
+                                            &fldArraySize));
+        /* Same restrictions as setnative */
+        if (structP->dynamicCountFieldIndex == fldIndex)
+            return CffiErrorStructCountField(ip, objv[2]);
+        if (CffiTypeIsVariableSize(
+                &structP->fields[fldIndex].fieldType.dataType))
+            return CffiErrorStructIsVariableSize(ip, structP, "setnative");
+        return CffiNativeValueFromObj(ipCtxP,
+                                      &structP->fields[fldIndex].fieldType,
+                                      fldArraySize,
+                                      objv[3],
+                                      CFFI_F_PRESERVE_ON_ERROR,
+                                      fldAddr,
+                                      0,
+                                      NULL);
+    }
+    return TCL_OK;
 }
 
-/* Function: CffiStructGetNativeFieldsPointer
- * Gets the values of multiple fields from a native struct.
+static void
+CffiStructViewDeleter(ClientData cdata)
+{
+    CffiStructView *viewP = (CffiStructView *)cdata;
+    if (viewP->safe)
+        CffiPointerWatchRemove(viewP->ipCtxP, &viewP->watch);
+    CffiStructUnref(viewP->structP);
+    ckfree(viewP);
+}
+
+/* Function: CffiStructViewPointer
+ * Creates a command bound to a native struct.
  *
  * Parameters:
  * ip - Interpreter
  * objc - number of arguments in objv[]. Caller should have checked for
- *        total of 4-5 arguments.
+ *        total of 3-5 arguments.
  * objv - argument array. This includes the command and subcommand provided
  *   at the script level.
  * structCtxP - pointer to struct context
@@ -2162,140 +3634,125 @@ CffiStructSetNativeUnsafeCmd(Tcl_Interp *ip,
  *
  * The **objv** contains the following arguments:
  * objv[2] - pointer to memory holding the struct value
- * objv[3] - list of field names
- * objv[4] - optional, index into array of structs pointed to by objv[2]
+ * objv[3] - optional, index into array of structs pointed to by objv[2]
+ * objv[4] - optional, name of the command to create. A name is generated
+ *   if not specified.
+ *
+ * The pointer is verified and the struct address computed once when
+ * the view is created. Safe views are recorded in the interpreter context
+ * so they can be invalidated when the pointer is disposed of.
  *
  * Returns:
- * *TCL_OK* on success with an empty interp result;
+ * *TCL_OK* on success with the fully qualified command name as interp result;
  * *TCL_ERROR* on failure with an error message in the interpreter.
  */
 static CffiResult
-CffiStructGetNativeFieldsPointer(Tcl_Interp *ip,
-                                 int objc,
-                                 Tcl_Obj *const objv[],
-                                 CffiStructCmdCtx *structCtxP,
-                                 int safe)
+CffiStructViewPointer(Tcl_Interp *ip,
+                      int objc,
+                      Tcl_Obj *const objv[],
+                      CffiStructCmdCtx *structCtxP,
+                      int safe)
 {
-    CffiStruct *structP = structCtxP->structP;
     CffiInterpCtx *ipCtxP = structCtxP->ipCtxP;
+    CffiStruct *structP   = structCtxP->structP;
+    CffiStructView *viewP;
+    Tcl_Obj *cmdNameObj;
+    void *pointer;
     void *structAddr;
-    Tcl_Size nNames;
-    int ret;
-
-    /* S fieldpointer POINTER FIELDNAMES ?INDEX? */
-    CFFI_ASSERT(objc >= 4);
 
-    CHECK(CffiStructComputeAddress(structCtxP->ipCtxP,
-                                   structP,
-                                   objv[2],
-                                   safe,
-                                   objc > 4 ? objv[4] : NULL,
-                                   &structAddr));
+    /* S view POINTER ?INDEX? ?CMDNAME? */
+    CFFI_ASSERT(objc >= 3);
 
-    /*
-     * Just a little note here about not using Tcl_ListObjGetElements
-     * here - the fear is that it may shimmer in one of the calls.
-     * To guard against that we would need to call Tcl_DuplicateObj.
-     * That is slower than the below approach since number of fields
-     * is likely quite small.
-     */
-    ret = Tcl_ListObjLength(ip, objv[3], &nNames);
-    if (ret == TCL_OK) {
-        Tcl_Obj *valueObj;
-        Tcl_Obj *valuesObj;
-        int i;
-        valuesObj = Tcl_NewListObj(nNames, NULL);
-        for (i = 0; ret == TCL_OK && i < nNames; ++i) {
-            Tcl_Obj *nameObj;
-            int fldIndex;
-            void *fldAddr;
-            int fldArraySize;
-            Tcl_ListObjIndex(NULL, objv[3], i, &nameObj);
-            Tcl_IncrRefCount(nameObj);
-            ret = CffiStructComputeFieldAddress(ipCtxP,
-                                                structP,
-                                                structAddr,
-                                                nameObj,
-                                                &fldIndex,
-                                                &fldAddr,
-                                                &fldArraySize);
-            Tcl_DecrRefCount(nameObj);
-            if (ret == TCL_OK) {
-                ret = CffiNativeValueToObj(ipCtxP,
-                                           &structP->fields[fldIndex].fieldType,
-                                           fldAddr,
-                                           0,
-                                           fldArraySize,
-                                           &valueObj);
-                if (ret == TCL_OK) {
-                    Tcl_ListObjAppendElement(NULL, valuesObj, valueObj);
-                }
-            }
-        }
-        if (ret == TCL_OK)
-            Tcl_SetObjResult(ip, valuesObj);
-        else
-            Tcl_DecrRefCount(valuesObj);
+    CHECK(CffiStructComputeAddress(
+        ipCtxP, structP, objv[2], safe, NULL, &pointer));
+    if (objc > 3) {
+        CHECK(CffiStructComputeAddress(
+            ipCtxP, structP, objv[2], safe, objv[3], &structAddr));
     }
-    return ret;
+    else
+        structAddr = pointer;
+
+    viewP             = ckalloc(sizeof(*viewP));
+    viewP->ipCtxP     = ipCtxP;
+    viewP->structP    = structP;
+    viewP->pointer    = pointer;
+    viewP->structAddr = structAddr;
+    viewP->safe       = safe;
+    CffiStructRef(structP);
+    if (safe)
+        CffiPointerWatchAdd(ipCtxP, &viewP->watch, pointer);
+
+    if (objc > 4)
+        cmdNameObj = Tclh_NsQualifyNameObj(ip, objv[4], NULL);
+    else
+        cmdNameObj = Tcl_ObjPrintf("::cffi::view%u", ++ipCtxP->viewId);
+    Tcl_IncrRefCount(cmdNameObj);
+    Tcl_CreateObjCommand(ip,
+                         Tcl_GetString(cmdNameObj),
+                         CffiStructViewInstanceCmd,
+                         viewP,
+                         CffiStructViewDeleter);
+    Tcl_SetObjResult(ip, cmdNameObj);
+    Tcl_DecrRefCount(cmdNameObj);
+    return TCL_OK;
 }
 
-/* Function: CffiStructGetNativeFieldsCmd
- * Gets the values of multiple fields from a native struct.
+/* Function: CffiStructViewCmd
+ * Creates a command bound to a native struct.
  *
  * Parameters:
  * ip - Interpreter
  * objc - number of arguments in objv[]. Caller should have checked for
- *        total of 4-5 arguments.
+ *        total of 3-5 arguments.
  * objv - argument array. This includes the command and subcommand provided
  *   at the script level.
  * structCtxP - pointer to struct context
  *
  * The **objv** contains the following arguments:
  * objv[2] - safe pointer to memory holding the struct value
- * objv[3] - list of field names
- * objv[4] - optional, index into array of structs pointed to by objv[2]
+ * objv[3] - optional, index into array of structs pointed to by objv[2]
+ * objv[4] - optional, name of the command to create
  *
  * Returns:
- * *TCL_OK* on success with an empty interp result;
+ * *TCL_OK* on success with the fully qualified command name as interp result;
  * *TCL_ERROR* on failure with an error message in the interpreter.
  */
 static CffiResult
-CffiStructGetNativeFieldsCmd(Tcl_Interp *ip,
-                             int objc,
-                             Tcl_Obj *const objv[],
-                             CffiStructCmdCtx *structCtxP)
+CffiStructViewCmd(Tcl_Interp *ip,
+                  int objc,
+                  Tcl_Obj *const objv[],
+                  CffiStructCmdCtx *structCtxP)
 {
-    return CffiStructGetNativeFieldsPointer(ip, objc, objv, structCtxP, 1);
+    return CffiStructViewPointer(ip, objc, objv, structCtxP, 1);
 }
 
-/* Function: CffiStructGetNativeFieldsUnsafeCmd
- * Gets the values of multiple fields from a native struct.
+/* Function: CffiStructViewUnsafeCmd
+ * Creates a command bound to a native struct.
  *
  * Parameters:
  * ip - Interpreter
  * objc - number of arguments in objv[]. Caller should have checked for
- *        total of 4-5 arguments.
+ *        total of 3-5 arguments.
  * objv - argument array. This includes the command and subcommand provided
  *   at the script level.
  * structCtxP - pointer to struct context
  *
  * The **objv** contains the following arguments:
  * objv[2] - unsafe pointer to memory holding the struct value
- * objv[3] - list of field names
- * objv[4] - optional, index into array of structs pointed to by objv[2]
+ * objv[3] - optional, index into array of structs pointed to by objv[2]
+ * objv[4] - optional, name of the command to create
  *
  * Returns:
- * *TCL_OK* on success with an empty interp result;
+ * *TCL_OK* on success with the fully qualified command name as interp result;
  * *TCL_ERROR* on failure with an error message in the interpreter.
  */
 static CffiResult
-CffiStructGetNativeFieldsUnsafeCmd(Tcl_Interp *ip,
-                                   int objc,
-                                   Tcl_Obj *const objv[],
-                                   CffiStructCmdCtx *structCtxP)
+CffiStructViewUnsafeCmd(Tcl_Interp *ip,
+                        int objc,
+                        Tcl_Obj *const objv[],
+                        CffiStructCmdCtx *structCtxP)
 {
-    return CffiStructGetNativeFieldsPointer(ip, objc, objv, structCtxP, 0);
+    return CffiStructViewPointer(ip, objc, objv, structCtxP, 0);
 }
 
 /* Function: CffiStructFieldPointerCmd
@@ -2353,6 +3810,55 @@ CffiStructFieldPointerCmd(Tcl_Interp *ip,
     return TCL_OK;
 }
 
+/* Function: CffiStructPoolCmd
+ * Configures and returns statistics for the struct allocation pool.
+ *
+ * Parameters:
+ * ip - Interpreter
+ * objc - number of arguments in objv[]. Caller should have checked for
+ *        total of 2-3 arguments.
+ * objv - argument array. This includes the command and subcommand provided
+ *   at the script level.
+ * structCtxP - pointer to struct context
+ *
+ * The **objv** contains the following arguments:
+ * objv[2] - optional, maximum number of freed allocations to retain.
+ *   0 disables pooling.
+ *
+ * Returns:
+ * *TCL_OK* on success with a dictionary of pool settings and statistics
+ * as interp result, *TCL_ERROR* on failure with message in interpreter.
+ */
+static CffiResult
+CffiStructPoolCmd(Tcl_Interp *ip,
+                  int objc,
+                  Tcl_Obj *const objv[],
+                  CffiStructCmdCtx *structCtxP)
+{
+    CffiStruct *structP = structCtxP->structP;
+    Tcl_Obj *objs[8];
+
+    if (objc > 2) {
+        Tcl_WideInt wide;
+        CHECK(Tclh_ObjToRangedInt(ip, objv[2], 0, INT_MAX, &wide));
+        if (wide != 0 && CffiStructIsVariableSize(structP))
+            return CffiErrorStructIsVariableSize(ip, structP, "pool");
+        structP->poolMax = (int)wide;
+        CffiStructPoolTrim(structP, structP->poolMax);
+    }
+
+    objs[0] = Tcl_NewStringObj("max", 3);
+    objs[1] = Tcl_NewIntObj(structP->poolMax);
+    objs[2] = Tcl_NewStringObj("free", 4);
+    objs[3] = Tcl_NewIntObj(structP->poolFree);
+    objs[4] = Tcl_NewStringObj("hits", 4);
+    objs[5] = Tcl_NewWideIntObj((Tcl_WideInt)structP->poolHits);
+    objs[6] = Tcl_NewStringObj("misses", 6);
+    objs[7] = Tcl_NewWideIntObj((Tcl_WideInt)structP->poolMisses);
+    Tcl_SetObjResult(ip, Tcl_NewListObj(sizeof(objs) / sizeof(objs[0]), objs));
+    return TCL_OK;
+}
+
 /* Function: CffiStructFreeCmd
  * Releases the memory allocated for a struct instance.
  *
@@ -2384,8 +3890,10 @@ CffiStructFreeCmd(Tcl_Interp *ip,
                                     objv[2],
                                     &valueP,
                                     structCtxP->structP->name);
-    if (ret == TCL_OK && valueP)
-        ckfree(valueP);
+    if (ret == TCL_OK && valueP) {
+        CffiPointerWatchesInvalidate(structCtxP->ipCtxP, valueP);
+        CffiStructPoolFree(structCtxP->ipCtxP, structCtxP->structP, valueP);
+    }
     return ret;
 }
 
@@ -2551,6 +4059,7 @@ CffiStructInstanceCmd(ClientData cdata,
 {
     CffiStructCmdCtx *structCtxP = (CffiStructCmdCtx *)cdata;
     static const Tclh_SubCommand subCommands[] = {
+        {"accessor", 2, 3, "CMDNAME FIELD ?-unsafe?", CffiStructAccessorCmd},
         {"allocate", 0, 4, "?-count COUNT? ?-vlacount VLACOUNT?", CffiStructAllocateCmd},
         {"describe", 0, 0, "", CffiStructDescribeCmd},
         {"destroy", 0, 0, "", CffiStructDestroyCmd},
@@ -2561,17 +4070,24 @@ CffiStructInstanceCmd(ClientData cdata,
         {"getnativefields!", 2, 3, "POINTER FIELDNAMES ?INDEX?", CffiStructGetNativeFieldsUnsafeCmd},
         {"free", 1, 1, "POINTER", CffiStructFreeCmd},
         {"frombinary", 1, 1, "BINARY", CffiStructFromBinaryCmd},
+        {"fromcolumns", 2, 3, "POINTER COLUMNS ?FIELDNAMES?", CffiStructFromColumnsCmd},
+        {"fromcolumns!", 2, 3, "POINTER COLUMNS ?FIELDNAMES?", CffiStructFromColumnsUnsafeCmd},
         {"fromnative", 1, 2, "POINTER ?INDEX?", CffiStructFromNativeCmd},
         {"fromnative!", 1, 2, "POINTER ?INDEX?", CffiStructFromNativeUnsafeCmd},
         {"info", 0, 2, "?-vlacount VLACOUNT?", CffiStructInfoCmd},
         {"name", 0, 0, "", CffiStructNameCmd},
         {"new", 0, 1, "?INITIALIZER?", CffiStructNewCmd},
+        {"pool", 0, 1, "?MAXFREE?", CffiStructPoolCmd},
         {"setnative", 3, 4, "POINTER FIELD VALUE ?INDEX?", CffiStructSetNativeCmd},
         {"setnative!", 3, 4, "POINTER FIELD VALUE ?INDEX?", CffiStructSetNativeUnsafeCmd},
         {"size", 0, 2, "?-vlacount VLACOUNT?", CffiStructSizeCmd},
         {"tobinary", 1, 1, "DICTIONARY", CffiStructToBinaryCmd},
+        {"tocolumns", 2, 3, "POINTER COUNT ?FIELDNAMES?", CffiStructToColumnsCmd},
+        {"tocolumns!", 2, 3, "POINTER COUNT ?FIELDNAMES?", CffiStructToColumnsUnsafeCmd},
         {"tonative", 2, 3, "POINTER INITIALIZER ?INDEX?", CffiStructToNativeCmd},
         {"tonative!", 2, 3, "POINTER INITIALIZER ?INDEX?", CffiStructToNativeUnsafeCmd},
+        {"view", 1, 3, "POINTER ?INDEX? ?CMDNAME?", CffiStructViewCmd},
+        {"view!", 1, 3, "POINTER ?INDEX? ?CMDNAME?", CffiStructViewUnsafeCmd},
         {NULL}
     };
     int cmdIndex;
@@ -2580,6 +4096,30 @@ CffiStructInstanceCmd(ClientData cdata,
     return subCommands[cmdIndex].cmdFn(ip, objc, objv, structCtxP);
 }
 
+/* Function: CffiStructOrUnionRenameTrace
+ * Command trace invalidating cached type parses when a struct or union
+ * command is renamed.
+ *
+ * Parameters:
+ * cdata - interpreter context
+ * ip - interpreter
+ * oldName - old name of the command
+ * newName - new name of the command. NULL or empty if deleted.
+ * flags - trace flags
+ *
+ * Deletion is handled by <CffiStructOrUnionInstanceDeleter>.
+ */
+static void
+CffiStructOrUnionRenameTrace(ClientData cdata,
+                             Tcl_Interp *ip,
+                             const char *oldName,
+                             const char *newName,
+                             int flags)
+{
+    CffiInterpCtx *ipCtxP = (CffiInterpCtx *)cdata;
+    ipCtxP->typeEpoch += 1; /* Invalidate cached type parses */
+}
+
 static void
 CffiStructOrUnionInstanceDeleter(ClientData cdata)
 {
@@ -2587,6 +4127,7 @@ CffiStructOrUnionInstanceDeleter(ClientData cdata)
     if (ctxP->structP)
         CffiStructUnref(ctxP->structP);
     /* Note ctxP->ipCtxP is interp-wide and not to be freed here */
+    ctxP->ipCtxP->typeEpoch += 1; /* Invalidate cached type parses */
     ckfree(ctxP);
 }
 
@@ -2913,6 +4454,12 @@ CffiStructOrUnionObjCmd(ClientData cdata,
                                  : CffiUnionInstanceCmd,
                              structCtxP,
                              CffiStructOrUnionInstanceDeleter);
+        Tcl_TraceCommand(ip,
+                         Tcl_GetString(cmdNameObj),
+                         TCL_TRACE_RENAME,
+                         CffiStructOrUnionRenameTrace,
+                         ipCtxP);
+        ipCtxP->typeEpoch += 1; /* Invalidate cached type parses */
         Tcl_SetObjResult(ip, cmdNameObj);
     }
     Tcl_DecrRefCount(cmdNameObj);
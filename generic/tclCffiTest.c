@@ -219,6 +219,9 @@ EXTERN int noargs () { return 42; }
 EXTERN int onearg (int arga) { return -arga; }
 EXTERN int twoargs (int arga, int argb) { return arga + argb; }
 EXTERN int threeargs (int arga, int argb, int argc) { return arga + argb + argc; }
+EXTERN int twoargs_string (int arga, int argb, const char *s) {
+    return arga + argb + (int) strlen(s) - 1;
+}
 
 DLLEXPORT double CFFI_STDCALL stdcalltest(double arga, double argb) {
   /* Division so order of argument errors will be caught */
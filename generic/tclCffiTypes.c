@@ -9,11 +9,18 @@
 #include "tclCffiInt.h"
 #include <errno.h>
 
+#if defined(__SSE2__) || defined(_M_X64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CFFI_HAVE_SSE2
+#endif
+
 #define CFFI_VALID_INTEGER_ATTRS                                         \
     (CFFI_F_ATTR_PARAM_MASK | CFFI_F_ATTR_REQUIREMENT_MASK               \
      | CFFI_F_ATTR_SAVEERROR | CFFI_F_ATTR_ERROR_MASK | CFFI_F_ATTR_ENUM \
      | CFFI_F_ATTR_BITMASK | CFFI_F_ATTR_STRUCTSIZE                      \
-     | CFFI_F_ATTR_NOVALUECHECKS | CFFI_F_ATTR_DISCARD)
+     | CFFI_F_ATTR_NOVALUECHECKS | CFFI_F_ATTR_DISCARD | CFFI_F_ATTR_VECTOR \
+     | CFFI_F_ATTR_PACKED)
 
 /* Note string cannot be INOUT parameter */
 #define CFFI_VALID_STRING_ATTRS                                                \
@@ -96,7 +103,7 @@ const struct CffiBaseTypeInfo cffiBaseTypes[] = {
      /* Note NUMERIC left out of float and double for now as the same error
         checks do not apply */
      CFFI_F_ATTR_PARAM_MASK | CFFI_F_ATTR_SAVEERROR | CFFI_F_ATTR_NOVALUECHECKS
-         | CFFI_F_ATTR_DISCARD,
+         | CFFI_F_ATTR_DISCARD | CFFI_F_ATTR_VECTOR | CFFI_F_ATTR_PACKED,
      sizeof(float)},
     {TOKENANDLEN(double),
      DCSIG(DOUBLE),
@@ -104,7 +111,7 @@ const struct CffiBaseTypeInfo cffiBaseTypes[] = {
      /* Note NUMERIC left out of float and double for now as the same error
         checks do not apply */
      CFFI_F_ATTR_PARAM_MASK | CFFI_F_ATTR_SAVEERROR | CFFI_F_ATTR_NOVALUECHECKS
-         | CFFI_F_ATTR_DISCARD,
+         | CFFI_F_ATTR_DISCARD | CFFI_F_ATTR_VECTOR | CFFI_F_ATTR_PACKED,
      sizeof(double)},
     {TOKENANDLEN(struct),
      DCSIG(AGGREGATE),
@@ -206,6 +213,9 @@ enum cffiTypeAttrOpt {
     NULLOK,
     SAVEERROR,
     PINNED,
+    OUTDICT,
+    VECTOR,
+    PACKED,
 };
 typedef struct CffiAttrs {
     const char *attrName; /* Token */
@@ -280,6 +290,9 @@ static CffiAttrs cffiAttrs[] = {
     {"nullok", NULLOK, /* synonym */ -1, CFFI_F_TYPE_PARSE_ALL, 1},
     {"saveerrors", SAVEERROR, CFFI_F_ATTR_SAVEERROR, CFFI_F_TYPE_PARSE_RETURN, 1},
     {"pinned", PINNED, CFFI_F_ATTR_PINNED, CFFI_F_TYPE_PARSE_ALL, 1},
+    {"outdict", OUTDICT, CFFI_F_ATTR_OUTDICT, CFFI_F_TYPE_PARSE_RETURN, 1},
+    {"vector", VECTOR, CFFI_F_ATTR_VECTOR, CFFI_F_TYPE_PARSE_ALL, 1},
+    {"packed", PACKED, CFFI_F_ATTR_PACKED, CFFI_F_TYPE_PARSE_ALL, 1},
     {NULL}};
 
 CffiResult
@@ -877,7 +890,7 @@ CffiTypeSizeForValue(CffiInterpCtx *ipCtxP,
     if (typeAttrsP == NULL)
         typeAttrsP = &typeAttrs;
 
-    CHECK(CffiTypeAndAttrsParse(
+    CHECK(CffiTypeAndAttrsParseCached(
         ipCtxP, typeObj, CFFI_F_TYPE_PARSE_FIELD, typeAttrsP));
 
     CffiResult ret;
@@ -1101,9 +1114,12 @@ CffiTypeAndAttrsParse(CffiInterpCtx *ipCtxP,
         /*
          * Check if the attribute is valid for the type. For the moment,
          * always permit NULLIFEMPTY. We will check again after all
-         * annotations are collected.
+         * annotations are collected. OUTDICT applies to the function as a
+         * whole, not the return type, so is permitted for all types.
          */
-        if ((cffiAttrs[attrIndex].attrFlag & (CFFI_F_ATTR_NULLIFEMPTY | validAttrs)) == 0) {
+        if ((cffiAttrs[attrIndex].attrFlag
+             & (CFFI_F_ATTR_NULLIFEMPTY | CFFI_F_ATTR_OUTDICT | validAttrs))
+            == 0) {
             message = "A type annotation is not valid for the data type.";
             goto invalid_format;
         }
@@ -1300,6 +1316,19 @@ CffiTypeAndAttrsParse(CffiInterpCtx *ipCtxP,
         case SAVEERROR:
             flags |= CFFI_F_ATTR_SAVEERROR;
             break;
+        case OUTDICT:
+            flags |= CFFI_F_ATTR_OUTDICT;
+            break;
+        case VECTOR:
+            if (flags & CFFI_F_ATTR_PACKED)
+                goto invalid_format;
+            flags |= CFFI_F_ATTR_VECTOR;
+            break;
+        case PACKED:
+            if (flags & CFFI_F_ATTR_VECTOR)
+                goto invalid_format;
+            flags |= CFFI_F_ATTR_PACKED;
+            break;
         }
     }
 
@@ -1341,6 +1370,15 @@ CffiTypeAndAttrsParse(CffiInterpCtx *ipCtxP,
         goto invalid_format;
     }
 
+    if ((flags & (CFFI_F_ATTR_VECTOR | CFFI_F_ATTR_PACKED))
+        && (CffiTypeIsNotArray(&typeAttrP->dataType)
+            || (flags & (CFFI_F_ATTR_ENUM | CFFI_F_ATTR_BITMASK)))) {
+        message = "The vector and packed annotations are only valid for "
+                  "arrays of numeric types without enum or bitmask "
+                  "annotations.";
+        goto invalid_format;
+    }
+
     switch (parseMode) {
     case CFFI_F_TYPE_PARSE_PARAM:
         if (baseType == CFFI_K_TYPE_VOID) {
@@ -1595,6 +1633,121 @@ void CffiTypeAndAttrsCleanup (CffiTypeAndAttrs *typeAttrsP)
 }
 
 
+/*
+ * Type declaration Tcl_Obj internal representation caching the parsed
+ * form. internalRep.twoPtrValue.ptr1 holds a CffiCachedTypeAndAttrs which
+ * is shared, through its reference count, by duplicates of the Tcl_Obj.
+ * A parse is only valid for the interpreter, namespace and parse mode it
+ * was done in and is discarded when aliases, enums or structs have been
+ * (re)defined since, as indicated by the interpreter type epoch.
+ */
+typedef struct CffiCachedTypeAndAttrs {
+    int nRefs;
+    CffiInterpCtx *ipCtxP;  /* Interpreter context of the parse */
+    Tcl_Namespace *nsP;     /* Namespace the type was resolved in */
+    unsigned int typeEpoch; /* CffiInterpCtx.typeEpoch at parse time */
+    int parseMode;          /* Parse mode flags */
+    CffiTypeAndAttrs typeAttrs;
+} CffiCachedTypeAndAttrs;
+
+static void CffiTypeAndAttrsFreeIntRep(Tcl_Obj *objP);
+static void CffiTypeAndAttrsDupIntRep(Tcl_Obj *srcObj, Tcl_Obj *dstObj);
+static const Tcl_ObjType cffiTypeAndAttrsObjType = {
+    "cffiTypeAndAttrs",
+    CffiTypeAndAttrsFreeIntRep,
+    CffiTypeAndAttrsDupIntRep,
+    NULL, /* updateStringProc - string rep always kept */
+    NULL, /* setFromAnyProc */
+};
+
+static void
+CffiTypeAndAttrsFreeIntRep(Tcl_Obj *objP)
+{
+    CffiCachedTypeAndAttrs *cacheP =
+        (CffiCachedTypeAndAttrs *)objP->internalRep.twoPtrValue.ptr1;
+    if (--cacheP->nRefs <= 0) {
+        CffiTypeAndAttrsCleanup(&cacheP->typeAttrs);
+        ckfree(cacheP);
+    }
+    objP->typePtr = NULL;
+}
+
+static void
+CffiTypeAndAttrsDupIntRep(Tcl_Obj *srcObj, Tcl_Obj *dstObj)
+{
+    CffiCachedTypeAndAttrs *cacheP =
+        (CffiCachedTypeAndAttrs *)srcObj->internalRep.twoPtrValue.ptr1;
+    cacheP->nRefs += 1;
+    dstObj->internalRep.twoPtrValue.ptr1 = cacheP;
+    dstObj->internalRep.twoPtrValue.ptr2 = NULL;
+    dstObj->typePtr                      = &cffiTypeAndAttrsObjType;
+}
+
+/* Function: CffiTypeAndAttrsParseCached
+ * Parses a type and attribute definition, caching the result in the
+ * definition Tcl_Obj.
+ *
+ * Parameters:
+ *   ipCtxP - Interpreter context
+ *   typeAttrObj - parameter definition object
+ *   parseMode - as for <CffiTypeAndAttrsParse>
+ *   typeAttrP - pointer to structure to hold parsed information.
+ *
+ * This is a drop-in replacement for <CffiTypeAndAttrsParse> for commands
+ * that are passed a type declaration on every invocation. The caller
+ * receives its own copy of the parsed type and must clean it up with
+ * <CffiTypeAndAttrsCleanup> as usual, so the cached parse may be freely
+ * discarded if typeAttrObj shimmers while the copy is in use.
+ *
+ * Returns:
+ * TCL_OK on success, else TCL_ERROR with an error message in the interpreter.
+ */
+CffiResult
+CffiTypeAndAttrsParseCached(CffiInterpCtx *ipCtxP,
+                            Tcl_Obj *typeAttrObj,
+                            CffiTypeParseMode parseMode,
+                            CffiTypeAndAttrs *typeAttrP)
+{
+    CffiCachedTypeAndAttrs *cacheP;
+    Tcl_Namespace *nsP = Tcl_GetCurrentNamespace(ipCtxP->interp);
+
+    if (typeAttrObj->typePtr == &cffiTypeAndAttrsObjType) {
+        cacheP = (CffiCachedTypeAndAttrs *)
+                     typeAttrObj->internalRep.twoPtrValue.ptr1;
+        if (cacheP->ipCtxP == ipCtxP && cacheP->nsP == nsP
+            && cacheP->typeEpoch == ipCtxP->typeEpoch
+            && cacheP->parseMode == (int)parseMode) {
+            CffiTypeAndAttrsInit(typeAttrP, &cacheP->typeAttrs);
+            return TCL_OK;
+        }
+    }
+
+    cacheP = ckalloc(sizeof(*cacheP));
+    if (CffiTypeAndAttrsParse(
+            ipCtxP, typeAttrObj, parseMode, &cacheP->typeAttrs)
+        != TCL_OK) {
+        ckfree(cacheP);
+        return TCL_ERROR;
+    }
+    cacheP->nRefs     = 1;
+    cacheP->ipCtxP    = ipCtxP;
+    cacheP->nsP       = nsP;
+    cacheP->typeEpoch = ipCtxP->typeEpoch;
+    cacheP->parseMode = parseMode;
+
+    /* Ensure string rep exists before discarding the list intrep */
+    (void)Tcl_GetString(typeAttrObj);
+    if (typeAttrObj->typePtr && typeAttrObj->typePtr->freeIntRepProc)
+        typeAttrObj->typePtr->freeIntRepProc(typeAttrObj);
+    typeAttrObj->internalRep.twoPtrValue.ptr1 = cacheP;
+    typeAttrObj->internalRep.twoPtrValue.ptr2 = NULL;
+    typeAttrObj->typePtr                      = &cffiTypeAndAttrsObjType;
+
+    CffiTypeAndAttrsInit(typeAttrP, &cacheP->typeAttrs);
+    return TCL_OK;
+}
+
+
 /* Function: CffiIntValueFromObj
  * Converts a *Tcl_Obj* to an integer with support for enums and bitmasks
  *
@@ -1858,11 +2011,11 @@ CffiNativeScalarFromObj(CffiInterpCtx *ipCtxP,
                 Tcl_DStringInit(&ds);
                 Tcl_DStringSetLength(&ds, len);
                 tempP = Tcl_DStringValue(&ds);
-                /* TBD - turn off PRESERVE_ON_ERROR in flags? */
+                /* Already preserving so no need for another copy */
                 ret = CffiStructFromObj(ipCtxP,
                                         typeAttrsP->dataType.u.structP,
                                         valueObj,
-                                        flags,
+                                        flags & ~CFFI_F_PRESERVE_ON_ERROR,
                                         tempP,
                                         memlifoP);
                 if (ret == TCL_OK) {
@@ -1977,6 +2130,176 @@ CffiNativeScalarFromObj(CffiInterpCtx *ipCtxP,
 #undef STOREINT_
 }
 
+/* Function: CffiNumericArrayFromObjs
+ * Stores an array of native numeric values from Tcl_Obj wrappers.
+ *
+ * Parameters:
+ * ip - interpreter for error messages. May be NULL.
+ * baseType - the integer or floating point base type of the array
+ * valueObjs - values to convert
+ * nValues - number of elements in valueObjs
+ * valueP - location of the native array
+ *
+ * This is the bulk equivalent of <CffiNativeScalarFromObj> for numeric
+ * types that are not enums or bitmasks. The element type is dispatched
+ * once for the whole array instead of per element.
+ *
+ * On error return, the contents of the native array are undefined.
+ *
+ * Returns:
+ * *TCL_OK* on success or *TCL_ERROR* on error with message stored in the
+ * interpreter.
+ */
+CffiResult
+CffiNumericArrayFromObjs(Tcl_Interp *ip,
+                         CffiBaseType baseType,
+                         Tcl_Obj *const *valueObjs,
+                         Tcl_Size nValues,
+                         void *valueP)
+{
+    Tcl_Size i;
+
+#define STOREARRAY_(objfn_, type_)                          \
+    do {                                                    \
+        type_ *p_ = (type_ *)valueP;                        \
+        for (i = 0; i < nValues; ++i) {                     \
+            if (objfn_(ip, valueObjs[i], &p_[i]) != TCL_OK) \
+                return TCL_ERROR;                           \
+        }                                                   \
+    } while (0)
+
+    switch (baseType) {
+    case CFFI_K_TYPE_SCHAR:
+        STOREARRAY_(ObjToChar, signed char);
+        break;
+    case CFFI_K_TYPE_UCHAR:
+        STOREARRAY_(ObjToUChar, unsigned char);
+        break;
+    case CFFI_K_TYPE_SHORT:
+        STOREARRAY_(ObjToShort, short);
+        break;
+    case CFFI_K_TYPE_USHORT:
+        STOREARRAY_(ObjToUShort, unsigned short);
+        break;
+    case CFFI_K_TYPE_INT:
+        STOREARRAY_(ObjToInt, int);
+        break;
+    case CFFI_K_TYPE_UINT:
+        STOREARRAY_(ObjToUInt, unsigned int);
+        break;
+    case CFFI_K_TYPE_LONG:
+        STOREARRAY_(ObjToLong, long);
+        break;
+    case CFFI_K_TYPE_ULONG:
+        STOREARRAY_(ObjToULong, unsigned long);
+        break;
+    case CFFI_K_TYPE_LONGLONG:
+        STOREARRAY_(ObjToLongLong, long long);
+        break;
+    case CFFI_K_TYPE_ULONGLONG:
+        STOREARRAY_(ObjToULongLong, unsigned long long);
+        break;
+    case CFFI_K_TYPE_FLOAT:
+        STOREARRAY_(ObjToFloat, float);
+        break;
+    case CFFI_K_TYPE_DOUBLE:
+        STOREARRAY_(ObjToDouble, double);
+        break;
+    default:
+        return Tclh_ErrorGeneric(
+            ip,
+            NULL,
+            "Internal error: CffiNumericArrayFromObjs called on "
+            "non-numeric type.");
+    }
+#undef STOREARRAY_
+    return TCL_OK;
+}
+
+/* Function: CffiNumericArrayToObj
+ * Wraps an array of native numeric values as a Tcl list.
+ *
+ * Parameters:
+ * baseType - the integer or floating point base type of the array
+ * valueP - location of the native array
+ * count - number of elements in the array
+ *
+ * This is the bulk equivalent of <CffiNativeScalarToObj> for numeric
+ * types. The element type is dispatched once for the whole array and the
+ * list, allocated for *count* elements up front, filled in chunks.
+ *
+ * Returns:
+ * A list Tcl_Obj with reference count 0.
+ */
+#define CFFI_K_NUMERIC_ARRAY_CHUNK 64
+Tcl_Obj *
+CffiNumericArrayToObj(CffiBaseType baseType, const void *valueP, Tcl_Size count)
+{
+    Tcl_Obj *chunkObjs[CFFI_K_NUMERIC_ARRAY_CHUNK];
+    Tcl_Obj *listObj = Tcl_NewListObj(count, NULL);
+    Tcl_Size i, j, n;
+
+#define WRAPARRAY_(objfn_, type_)                            \
+    do {                                                     \
+        const type_ *p_ = (const type_ *)valueP;             \
+        for (i = 0; i < count; i += n) {                     \
+            n = count - i;                                   \
+            if (n > CFFI_K_NUMERIC_ARRAY_CHUNK)              \
+                n = CFFI_K_NUMERIC_ARRAY_CHUNK;              \
+            for (j = 0; j < n; ++j)                          \
+                chunkObjs[j] = objfn_(p_[i + j]);            \
+            Tcl_ListObjReplace(NULL, listObj, i, 0, n, chunkObjs); \
+        }                                                    \
+    } while (0)
+
+    switch (baseType) {
+    case CFFI_K_TYPE_SCHAR:
+        WRAPARRAY_(Tcl_NewWideIntObj, signed char);
+        break;
+    case CFFI_K_TYPE_UCHAR:
+        WRAPARRAY_(Tcl_NewWideIntObj, unsigned char);
+        break;
+    case CFFI_K_TYPE_SHORT:
+        WRAPARRAY_(Tcl_NewWideIntObj, short);
+        break;
+    case CFFI_K_TYPE_USHORT:
+        WRAPARRAY_(Tcl_NewWideIntObj, unsigned short);
+        break;
+    case CFFI_K_TYPE_INT:
+        WRAPARRAY_(Tcl_NewWideIntObj, int);
+        break;
+    case CFFI_K_TYPE_UINT:
+        WRAPARRAY_(Tcl_NewWideIntObj, unsigned int);
+        break;
+    case CFFI_K_TYPE_LONG:
+        WRAPARRAY_(Tcl_NewWideIntObj, long);
+        break;
+    case CFFI_K_TYPE_ULONG:
+        if (sizeof(unsigned long) == sizeof(Tcl_WideInt))
+            WRAPARRAY_(Tclh_ObjFromULongLong, unsigned long);
+        else
+            WRAPARRAY_(Tcl_NewWideIntObj, unsigned long);
+        break;
+    case CFFI_K_TYPE_LONGLONG:
+        WRAPARRAY_(Tcl_NewWideIntObj, long long);
+        break;
+    case CFFI_K_TYPE_ULONGLONG:
+        WRAPARRAY_(Tclh_ObjFromULongLong, unsigned long long);
+        break;
+    case CFFI_K_TYPE_FLOAT:
+        WRAPARRAY_(Tcl_NewDoubleObj, float);
+        break;
+    case CFFI_K_TYPE_DOUBLE:
+        WRAPARRAY_(Tcl_NewDoubleObj, double);
+        break;
+    default:
+        CFFI_ASSERT(0);
+        break;
+    }
+#undef WRAPARRAY_
+    return listObj;
+}
+
 /* Function: CffiNativeValueFromObj
  * Stores a native value of any type from Tcl_Obj wrapper
  *
@@ -2048,11 +2371,17 @@ CffiNativeValueFromObj(CffiInterpCtx *ipCtxP,
         Tcl_Obj **valueObjList;
         Tcl_Size indx, nvalues, count;
         int baseSize;
+        CffiBaseType baseType = typeAttrsP->dataType.baseType;
+        const void *vectorP;
+        int bulk;
 
         baseSize = typeAttrsP->dataType.baseTypeSize;
         count = typeAttrsP->dataType.arraySize;
         if (count == 0)
             count = realArraySize;
+        /* Plain numeric arrays are converted by a single typed loop */
+        bulk = CffiTypeIsNumeric(baseType)
+            && !(typeAttrsP->flags & (CFFI_F_ATTR_BITMASK | CFFI_F_ATTR_ENUM));
         if (count < 0)
             return Tclh_ErrorGeneric(
                 ip,
@@ -2133,6 +2462,39 @@ CffiNativeValueFromObj(CffiInterpCtx *ipCtxP,
                 CHECK(CffiBytesFromObjSafe(ip, valueObj, valueP, count, NULL));
                 break;
             default:
+                if (typeAttrsP->flags & CFFI_F_ATTR_PACKED) {
+                    /* Raw native bytes, whole elements only */
+                    Tcl_Size nBytes;
+                    unsigned char *bytesP =
+                        Tcl_GetByteArrayFromObj(valueObj, &nBytes);
+                    if ((nBytes % baseSize) != 0 || nBytes > count * baseSize) {
+                        return Tclh_ErrorInvalidValue(
+                            ip,
+                            NULL,
+                            "Packed array length is not a multiple of the "
+                            "element size or exceeds the array size.");
+                    }
+                    memmove(valueP, bytesP, nBytes);
+                    if (nBytes < count * baseSize) {
+                        memset(nBytes + (char *)valueP,
+                               0,
+                               count * baseSize - nBytes);
+                    }
+                    break;
+                }
+                /* Vectors of the same element type are copied as is */
+                vectorP = CffiVectorData(valueObj, baseType, &nvalues);
+                if (vectorP) {
+                    if (nvalues > count)
+                        nvalues = count;
+                    memcpy(valueP, vectorP, nvalues * baseSize);
+                    if (nvalues < count) {
+                        memset((baseSize * nvalues) + (char *)valueP,
+                               0,
+                               baseSize * (count - nvalues));
+                    }
+                    break;
+                }
                 /* Store each contained element */
                 if (Tcl_ListObjGetElements(
                         ip, valueObj, &nvalues, &valueObjList)
@@ -2145,7 +2507,12 @@ CffiNativeValueFromObj(CffiInterpCtx *ipCtxP,
                                        * array size */
                 if (nvalues > count)
                     nvalues = count;
-                if (!(flags & CFFI_F_PRESERVE_ON_ERROR)) {
+                if (bulk && !(flags & CFFI_F_PRESERVE_ON_ERROR)) {
+                    CHECK(CffiNumericArrayFromObjs(
+                        ip, baseType, valueObjList, nvalues, valueP));
+                    indx = nvalues;
+                }
+                else if (!(flags & CFFI_F_PRESERVE_ON_ERROR)) {
                     for (indx = 0; indx < nvalues; ++indx) {
                         CHECK(CffiNativeScalarFromObj(ipCtxP,
                                                       typeAttrsP,
@@ -2170,17 +2537,25 @@ CffiNativeValueFromObj(CffiInterpCtx *ipCtxP,
                      * called function to do so too so turn off
                      * PRESERVE_ON_ERROR
                      */
-                    for (indx = 0; indx < nvalues; ++indx) {
-                        ret = CffiNativeScalarFromObj(
-                            ipCtxP,
-                            typeAttrsP,
-                            valueObjList[indx],
-                            flags & ~CFFI_F_PRESERVE_ON_ERROR,
-                            tempP,
-                            indx,
-                            memlifoP);
-                        if (ret != TCL_OK)
-                            break; /* Need to free ds */
+                    ret = TCL_OK;
+                    if (bulk) {
+                        ret = CffiNumericArrayFromObjs(
+                            ip, baseType, valueObjList, nvalues, tempP);
+                        indx = nvalues;
+                    }
+                    else {
+                        for (indx = 0; indx < nvalues; ++indx) {
+                            ret = CffiNativeScalarFromObj(
+                                ipCtxP,
+                                typeAttrsP,
+                                valueObjList[indx],
+                                flags & ~CFFI_F_PRESERVE_ON_ERROR,
+                                tempP,
+                                indx,
+                                memlifoP);
+                            if (ret != TCL_OK)
+                                break; /* Need to free ds */
+                        }
                     }
                     if (ret == TCL_OK)
                         memcpy(valueP, tempP, totalSize);
@@ -2460,6 +2835,17 @@ CffiNativeValueToObj(CffiInterpCtx *ipCtxP,
         if (count < 0) {
             return CffiNativeScalarToObj(ipCtxP, typeAttrsP, valueP, 0, valueObjP);
         }
+        else if (CffiTypeIsNumeric(baseType)) {
+            if (typeAttrsP->flags & CFFI_F_ATTR_PACKED)
+                *valueObjP = Tcl_NewByteArrayObj(
+                    (unsigned char *)valueP,
+                    count * typeAttrsP->dataType.baseTypeSize);
+            else if (typeAttrsP->flags & CFFI_F_ATTR_VECTOR)
+                *valueObjP = CffiVectorNewObj(baseType, valueP, count);
+            else
+                *valueObjP = CffiNumericArrayToObj(baseType, valueP, count);
+            return TCL_OK;
+        }
         else {
             /* Array, possible even a single element, still represent as list */
             Tcl_Obj *listObj;
@@ -2699,6 +3085,68 @@ CffiUniStringToObj(Tcl_Interp *ip,
 
 
 
+/* Function: CffiIsAscii
+ * Checks whether a byte sequence is entirely 7-bit ASCII.
+ *
+ * Parameters:
+ * p - bytes to check
+ * len - number of bytes
+ *
+ * Sixteen bytes are checked at a time where SSE2 is available and eight
+ * otherwise.
+ *
+ * Returns:
+ * Non-zero if no byte has the high bit set, else 0.
+ */
+static int
+CffiIsAscii(const char *p, Tcl_Size len)
+{
+    const unsigned char *s = (const unsigned char *)p;
+    Tcl_Size i             = 0;
+
+#ifdef CFFI_HAVE_SSE2
+    for (; i + 16 <= len; i += 16) {
+        if (_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(s + i))))
+            return 0;
+    }
+#endif
+    for (; i + 8 <= len; i += 8) {
+        Tcl_WideUInt w;
+        memcpy(&w, s + i, sizeof(w));
+        if (w & (Tcl_WideUInt)0x8080808080808080)
+            return 0;
+    }
+    for (; i < len; ++i) {
+        if (s[i] & 0x80)
+            return 0;
+    }
+    return 1;
+}
+
+/* Function: CffiEncodingIsAsciiCompatible
+ * Checks whether an encoding represents 7-bit ASCII characters as is.
+ *
+ * Parameters:
+ * enc - encoding or *NULL* for the system encoding
+ *
+ * For such encodings, ASCII text is identical in the encoded form and
+ * in Tcl's internal form so may be copied without invoking the encoder.
+ * Only commonly used encodings are recognized.
+ *
+ * Returns:
+ * Non-zero if the encoding is known to be ASCII compatible, else 0.
+ */
+static int
+CffiEncodingIsAsciiCompatible(Tcl_Encoding enc)
+{
+    const char *name = Tcl_GetEncodingName(enc);
+
+    if (name == NULL)
+        return 0;
+    return !strcmp(name, "utf-8") || !strcmp(name, "ascii")
+        || !strncmp(name, "iso8859-", 8) || !strncmp(name, "cp125", 5);
+}
+
 /* Function: CffiCharsFromTclString
  * Encodes a Tcl utf8 string to a character array based on a type encoding.
  *
@@ -2730,6 +3178,13 @@ CffiCharsFromTclString(Tcl_Interp *ip,
     if (fromLen < 0)
         fromLen = Tclh_strlen(fromP);
 
+    /* ASCII in an ASCII compatible encoding needs no conversion */
+    if (fromLen < toSize && CffiEncodingIsAsciiCompatible(enc)
+        && CffiIsAscii(fromP, fromLen)) {
+        memcpy(toP, fromP, fromLen);
+        toP[fromLen] = '\0';
+        return TCL_OK;
+    }
 
 #ifdef TCLH_TCL87API
     flags =
@@ -2854,6 +3309,15 @@ CffiCharsInMemlifoFromObj(Tcl_Interp *ip,
     int status;
 
     srcP = Tcl_GetStringFromObj(srcObj, &srcLen);
+
+    /* ASCII in an ASCII compatible encoding needs no conversion */
+    if (CffiEncodingIsAsciiCompatible(enc) && CffiIsAscii(srcP, srcLen)) {
+        char *outP = Tclh_LifoAlloc(memlifoP, srcLen + 1);
+        memcpy(outP, srcP, srcLen + 1); /* Includes terminator */
+        *outPP = outP;
+        return TCL_OK;
+    }
+
 #ifdef TCLH_TCL87API
     flags = TCL_ENCODING_PROFILE_REPLACE;
 #else
@@ -2933,6 +3397,7 @@ CffiCharsToObj(Tcl_Interp *ip,
                Tcl_Obj **resultObjP)
 {
     Tcl_DString dsDecoded;
+    Tcl_Size srcLen;
 
     CFFI_ASSERT(typeAttrsP->dataType.baseType == CFFI_K_TYPE_CHAR_ARRAY
                 || typeAttrsP->dataType.baseType == CFFI_K_TYPE_ASTRING);
@@ -2942,6 +3407,15 @@ CffiCharsToObj(Tcl_Interp *ip,
         return TCL_OK;
     }
 
+    /* ASCII in an ASCII compatible encoding needs no conversion */
+    if (CffiEncodingIsAsciiCompatible(typeAttrsP->dataType.u.encoding)) {
+        srcLen = Tclh_strlen(srcP);
+        if (CffiIsAscii(srcP, srcLen)) {
+            *resultObjP = Tcl_NewStringObj(srcP, srcLen);
+            return TCL_OK;
+        }
+    }
+
     Tcl_DStringInit(&dsDecoded);
 
     /* TODO - use new UtfDString API and check error */
@@ -2950,6 +3424,7 @@ CffiCharsToObj(Tcl_Interp *ip,
     /* Should optimize this by direct transfer of ds storage - See TclDStringToObj */
     *resultObjP = Tcl_NewStringObj(Tcl_DStringValue(&dsDecoded),
                                    Tcl_DStringLength(&dsDecoded));
+    Tcl_DStringFree(&dsDecoded);
     return TCL_OK;
 }
 
@@ -3344,7 +3819,7 @@ CffiTypeFrombinaryCmd(CffiInterpCtx *ipCtxP,
     if (pv == NULL)
         return TCL_ERROR;
 
-    CHECK(CffiTypeAndAttrsParse(
+    CHECK(CffiTypeAndAttrsParseCached(
         ipCtxP, typeObj, CFFI_F_TYPE_PARSE_FIELD, &typeAttrs));
 
     ret = CffiNativeValueToObj(ipCtxP,
@@ -3423,7 +3898,7 @@ CffiTypeObjCmd(ClientData cdata,
         }
     }
 
-    CHECK(CffiTypeAndAttrsParse(ipCtxP, objv[2], parse_mode, &typeAttrs));
+    CHECK(CffiTypeAndAttrsParseCached(ipCtxP, objv[2], parse_mode, &typeAttrs));
     if (CffiTypeIsVariableSize(&typeAttrs.dataType) && vlaCount < 0) {
         CffiTypeAndAttrsCleanup(&typeAttrs);
         return CffiErrorMissingVLACountOption(ip);
@@ -0,0 +1,685 @@
+/*
+ * Copyright (c) 2024 Ashok P. Nadkarni
+ * All rights reserved.
+ *
+ * See the file LICENSE for license
+ */
+
+#include "tclCffiInt.h"
+
+/*
+ * Typed vectors.
+ *
+ * A vector is a Tcl_Obj whose internal representation is a contiguous
+ * native array of a numeric type. Vectors are accepted wherever an array
+ * of the same element type is expected and copied with no conversion of
+ * individual elements. Arrays annotated with *vector* are returned as
+ * vectors. The string representation is the list of element values and
+ * is only generated when needed. If the value is used as a list the
+ * native form is lost but the vector commands rebuild it when passed the
+ * element type.
+ *
+ * internalRep.twoPtrValue.ptr1 holds a CffiVector descriptor and ptr2 the
+ * native elements, NULL if the vector is empty.
+ */
+typedef struct CffiVector {
+    CffiBaseType baseType; /* Element type */
+    int elemSize;          /* Size of an element */
+    Tcl_Size count;        /* Number of elements */
+} CffiVector;
+
+static void CffiVectorFreeIntRep(Tcl_Obj *objP);
+static void CffiVectorDupIntRep(Tcl_Obj *srcObj, Tcl_Obj *dstObj);
+static void CffiVectorUpdateString(Tcl_Obj *objP);
+static const Tcl_ObjType cffiVectorObjType = {
+    "cffiVector",
+    CffiVectorFreeIntRep,
+    CffiVectorDupIntRep,
+    CffiVectorUpdateString,
+    NULL, /* setFromAnyProc - only created from native values */
+};
+
+static void
+CffiVectorFreeIntRep(Tcl_Obj *objP)
+{
+    ckfree(objP->internalRep.twoPtrValue.ptr1);
+    if (objP->internalRep.twoPtrValue.ptr2)
+        ckfree(objP->internalRep.twoPtrValue.ptr2);
+    objP->typePtr = NULL;
+}
+
+/* Function: CffiVectorSetIntRep
+ * Stores a copy of a native array as the internal representation.
+ *
+ * Parameters:
+ * objP - the Tcl_Obj. Must not have an internal representation.
+ * baseType - numeric element type
+ * elemSize - size of an element
+ * valueP - native array to copy. May be NULL in which case the elements
+ *    are initialized to zero.
+ * count - number of elements
+ */
+static void
+CffiVectorSetIntRep(Tcl_Obj *objP,
+                    CffiBaseType baseType,
+                    int elemSize,
+                    const void *valueP,
+                    Tcl_Size count)
+{
+    CffiVector *vecP = ckalloc(sizeof(*vecP));
+    void *dataP      = NULL;
+
+    vecP->baseType = baseType;
+    vecP->elemSize = elemSize;
+    vecP->count    = count;
+    if (count > 0) {
+        dataP = ckalloc(count * elemSize);
+        if (valueP)
+            memcpy(dataP, valueP, count * elemSize);
+        else
+            memset(dataP, 0, count * elemSize);
+    }
+    objP->internalRep.twoPtrValue.ptr1 = vecP;
+    objP->internalRep.twoPtrValue.ptr2 = dataP;
+    objP->typePtr                      = &cffiVectorObjType;
+}
+
+static void
+CffiVectorDupIntRep(Tcl_Obj *srcObj, Tcl_Obj *dstObj)
+{
+    CffiVector *vecP = (CffiVector *)srcObj->internalRep.twoPtrValue.ptr1;
+    CffiVectorSetIntRep(dstObj,
+                        vecP->baseType,
+                        vecP->elemSize,
+                        srcObj->internalRep.twoPtrValue.ptr2,
+                        vecP->count);
+}
+
+static void
+CffiVectorUpdateString(Tcl_Obj *objP)
+{
+    CffiVector *vecP = (CffiVector *)objP->internalRep.twoPtrValue.ptr1;
+    Tcl_Obj *listObj;
+    const char *p;
+    Tcl_Size len;
+
+    listObj = CffiNumericArrayToObj(
+        vecP->baseType, objP->internalRep.twoPtrValue.ptr2, vecP->count);
+    p            = Tcl_GetStringFromObj(listObj, &len);
+    objP->bytes  = ckalloc(len + 1);
+    memcpy(objP->bytes, p, len + 1);
+    objP->length = len;
+    Tcl_DecrRefCount(listObj);
+}
+
+/* Function: CffiVectorNewObj
+ * Returns a vector Tcl_Obj holding a copy of a native numeric array.
+ *
+ * Parameters:
+ * baseType - numeric element type
+ * valueP - native array to copy. May be NULL in which case the elements
+ *    are initialized to zero.
+ * count - number of elements
+ *
+ * Returns:
+ * A Tcl_Obj with reference count 0.
+ */
+Tcl_Obj *
+CffiVectorNewObj(CffiBaseType baseType, const void *valueP, Tcl_Size count)
+{
+    Tcl_Obj *objP = Tcl_NewObj();
+
+    CFFI_ASSERT(CffiTypeIsNumeric(baseType));
+    Tcl_InvalidateStringRep(objP);
+    CffiVectorSetIntRep(
+        objP, baseType, cffiBaseTypes[baseType].size, valueP, count);
+    return objP;
+}
+
+/* Function: CffiVectorData
+ * Returns the native elements of a vector of a given element type.
+ *
+ * Parameters:
+ * objP - Tcl_Obj that may hold a vector
+ * baseType - required element type
+ * countP - location to store the number of elements
+ *
+ * The returned pointer is only valid as long as *objP* retains its
+ * internal representation.
+ *
+ * Returns:
+ * Pointer to the native elements or NULL if *objP* is not a vector
+ * with elements of type *baseType* or is empty.
+ */
+const void *
+CffiVectorData(Tcl_Obj *objP, CffiBaseType baseType, Tcl_Size *countP)
+{
+    CffiVector *vecP;
+
+    if (objP->typePtr != &cffiVectorObjType)
+        return NULL;
+    vecP = (CffiVector *)objP->internalRep.twoPtrValue.ptr1;
+    if (vecP->baseType != baseType)
+        return NULL;
+    *countP = vecP->count;
+    return objP->internalRep.twoPtrValue.ptr2;
+}
+
+/* Function: CffiVectorFromObj
+ * Retrieves the vector descriptor from a Tcl_Obj.
+ *
+ * Parameters:
+ * ipCtxP - interpreter context
+ * objP - the Tcl_Obj
+ * typeObj - element type of the vector. May be NULL.
+ * vecPP - location to store the vector descriptor
+ *
+ * If *typeObj* is specified and *objP* is not a vector with that element
+ * type, for example because it has been used as a list, it is converted
+ * to one from its list representation. The string representation is
+ * retained. If *typeObj* is NULL, *objP* must already be a vector.
+ *
+ * Returns:
+ * *TCL_OK* on success or *TCL_ERROR* on error with message stored in the
+ * interpreter.
+ */
+static CffiResult
+CffiVectorFromObj(CffiInterpCtx *ipCtxP,
+                  Tcl_Obj *objP,
+                  Tcl_Obj *typeObj,
+                  CffiVector **vecPP)
+{
+    Tcl_Interp *ip = ipCtxP->interp;
+    CffiTypeAndAttrs typeAttrs;
+    CffiBaseType baseType;
+    Tcl_Obj **valueObjs;
+    Tcl_Size count;
+    void *dataP;
+    int elemSize;
+    CffiResult ret;
+
+    if (typeObj == NULL) {
+        if (objP->typePtr != &cffiVectorObjType) {
+            return Tclh_ErrorWrongType(
+                ip,
+                objP,
+                "Value is not a vector. Specify the element type with the "
+                "-type option.");
+        }
+        *vecPP = (CffiVector *)objP->internalRep.twoPtrValue.ptr1;
+        return TCL_OK;
+    }
+
+    CHECK(CffiTypeAndAttrsParseCached(
+        ipCtxP, typeObj, CFFI_F_TYPE_PARSE_FIELD, &typeAttrs));
+    baseType = typeAttrs.dataType.baseType;
+    ret      = CffiTypeIsNumeric(baseType)
+            && !CffiTypeIsArray(&typeAttrs.dataType)
+            ? TCL_OK
+            : Tclh_ErrorWrongType(
+                ip, typeObj, "Vector element type must be a numeric type.");
+    CffiTypeAndAttrsCleanup(&typeAttrs);
+    if (ret != TCL_OK)
+        return ret;
+
+    if (objP->typePtr == &cffiVectorObjType) {
+        *vecPP = (CffiVector *)objP->internalRep.twoPtrValue.ptr1;
+        if ((*vecPP)->baseType == baseType)
+            return TCL_OK;
+    }
+
+    /* Rebuild the native form from the list representation */
+    CHECK(Tcl_ListObjGetElements(ip, objP, &count, &valueObjs));
+    elemSize = cffiBaseTypes[baseType].size;
+    dataP    = count > 0 ? ckalloc(count * elemSize) : NULL;
+    if (count > 0
+        && CffiNumericArrayFromObjs(ip, baseType, valueObjs, count, dataP)
+               != TCL_OK) {
+        ckfree(dataP);
+        return TCL_ERROR;
+    }
+    (void)Tcl_GetString(objP); /* String rep is retained */
+    if (objP->typePtr && objP->typePtr->freeIntRepProc)
+        objP->typePtr->freeIntRepProc(objP);
+    CffiVectorSetIntRep(objP, baseType, elemSize, dataP, count);
+    if (dataP)
+        ckfree(dataP);
+    *vecPP = (CffiVector *)objP->internalRep.twoPtrValue.ptr1;
+    return TCL_OK;
+}
+
+/* Function: CffiVectorTypeOption
+ * Parses the optional trailing -type option of the vector commands.
+ *
+ * Parameters:
+ * ip - interpreter for error messages
+ * objcP - location holding the count of elements in objv[]. Reduced by
+ *    two if the option is present.
+ * objv - argument array
+ * minObjc - number of arguments in objv[] excluding optional ones
+ * maxObjc - number of arguments in objv[] excluding the option
+ * typeObjP - location to store the option value. Set to NULL if the
+ *    option is not present.
+ *
+ * The option is present if there are at least two arguments beyond the
+ * required ones since the commands have at most one other optional
+ * argument.
+ *
+ * Returns:
+ * *TCL_OK* on success or *TCL_ERROR* on error with message stored in the
+ * interpreter.
+ */
+static CffiResult
+CffiVectorTypeOption(Tcl_Interp *ip,
+                     int *objcP,
+                     Tcl_Obj *const objv[],
+                     int minObjc,
+                     int maxObjc,
+                     Tcl_Obj **typeObjP)
+{
+    static const char *const opts[] = {"-type", NULL};
+    int objc = *objcP;
+    int opt;
+
+    *typeObjP = NULL;
+    if ((objc - minObjc) < 2) {
+        if (objc <= maxObjc)
+            return TCL_OK;
+        CHECK(Tcl_GetIndexFromObj(
+            ip, objv[objc - 1], opts, "option", 0, &opt));
+        return Tclh_ErrorOptionValueMissing(ip, objv[objc - 1], NULL);
+    }
+    CHECK(Tcl_GetIndexFromObj(ip, objv[objc - 2], opts, "option", 0, &opt));
+    *typeObjP = objv[objc - 1];
+    *objcP    = objc - 2;
+    return TCL_OK;
+}
+
+/* Function: CffiVectorIndexFromObj
+ * Parses a vector index
+ *
+ * Parameters:
+ * ip - interpreter for error messages
+ * indexObj - index to parse
+ * indexP - location to store the index
+ *
+ * Indices must be parsed before the vector descriptor is retrieved as
+ * the index may be the same Tcl_Obj as the vector and parsing it frees
+ * the vector internal representation. The range is checked afterwards
+ * with <CffiVectorIndexCheck>.
+ *
+ * Returns:
+ * *TCL_OK* on success or *TCL_ERROR* on error with message stored in the
+ * interpreter.
+ */
+static CffiResult
+CffiVectorIndexFromObj(Tcl_Interp *ip, Tcl_Obj *indexObj, Tcl_Size *indexP)
+{
+    Tcl_WideInt wide;
+
+    CHECK(Tclh_ObjToRangedInt(ip, indexObj, 0, INT_MAX, &wide));
+    *indexP = (Tcl_Size)wide;
+    return TCL_OK;
+}
+
+/* Function: CffiVectorIndexCheck
+ * Verifies a parsed index is within the bounds of a vector.
+ *
+ * Parameters:
+ * ip - interpreter for error messages
+ * vecP - vector descriptor
+ * indexObj - index as passed by the caller, for error messages
+ * indx - index parsed with <CffiVectorIndexFromObj>
+ *
+ * Returns:
+ * *TCL_OK* on success or *TCL_ERROR* on error with message stored in the
+ * interpreter.
+ */
+static CffiResult
+CffiVectorIndexCheck(Tcl_Interp *ip,
+                     const CffiVector *vecP,
+                     Tcl_Obj *indexObj,
+                     Tcl_Size indx)
+{
+    if (indx >= vecP->count)
+        return Tclh_ErrorInvalidValue(ip, indexObj, "Index out of range.");
+    return TCL_OK;
+}
+
+/* Function: CffiVectorNewCmd
+ * Implements the *vector new* script level command.
+ *
+ * Parameters:
+ * ipCtxP - interpreter context
+ * objc - count of elements in objv[]. Should be 3-4 including command
+ *        and subcommand.
+ * objv - argument array.
+ * flags - unused
+ *
+ * The command arguments given in objv[] are
+ *
+ * objv[2] - numeric type declaration, optionally a fixed size array
+ * objv[3] - optional list of initial values
+ *
+ * For scalar types, the number of elements is the number of initial
+ * values. For arrays, elements without an initial value are zero.
+ *
+ * Returns:
+ * *TCL_OK* on success with the vector as interpreter result,
+ * *TCL_ERROR* on failure with error message in interpreter.
+ */
+static CffiResult
+CffiVectorNewCmd(CffiInterpCtx *ipCtxP,
+                 int objc,
+                 Tcl_Obj *const objv[],
+                 CffiFlags flags)
+{
+    Tcl_Interp *ip = ipCtxP->interp;
+    CffiTypeAndAttrs typeAttrs;
+    CffiBaseType baseType;
+    Tcl_Obj **valueObjs = NULL;
+    Tcl_Obj *vecObj;
+    Tcl_Size count, nValues;
+    CffiResult ret;
+
+    CHECK(CffiTypeAndAttrsParseCached(
+        ipCtxP, objv[2], CFFI_F_TYPE_PARSE_FIELD, &typeAttrs));
+    baseType = typeAttrs.dataType.baseType;
+    count    = typeAttrs.dataType.arraySize;
+    ret      = TCL_ERROR;
+    if (!CffiTypeIsNumeric(baseType)) {
+        Tclh_ErrorWrongType(
+            ip, objv[2], "Vector element type must be a numeric type.");
+        goto vamoose;
+    }
+    if (CffiTypeIsVariableSize(&typeAttrs.dataType)) {
+        Tclh_ErrorGeneric(
+            ip, "VARSIZE", "Vectors of variable size are not permitted.");
+        goto vamoose;
+    }
+
+    nValues = 0;
+    if (objc > 3) {
+        if (Tcl_ListObjGetElements(ip, objv[3], &nValues, &valueObjs)
+            != TCL_OK)
+            goto vamoose;
+    }
+    if (count < 0)
+        count = nValues; /* Scalar type - size from initializer */
+    else if (nValues > count)
+        nValues = count;
+
+    vecObj = CffiVectorNewObj(baseType, NULL, count);
+    if (nValues > 0) {
+        if (CffiNumericArrayFromObjs(ip,
+                                     baseType,
+                                     valueObjs,
+                                     nValues,
+                                     vecObj->internalRep.twoPtrValue.ptr2)
+            != TCL_OK) {
+            Tcl_DecrRefCount(vecObj);
+            goto vamoose;
+        }
+    }
+    Tcl_SetObjResult(ip, vecObj);
+    ret = TCL_OK;
+
+vamoose:
+    CffiTypeAndAttrsCleanup(&typeAttrs);
+    return ret;
+}
+
+/* Function: CffiVectorGetCmd
+ * Implements the *vector get* script level command.
+ *
+ * Parameters:
+ * ipCtxP - interpreter context
+ * objc - count of elements in objv[]. Should be 3-6 including command
+ *        and subcommand.
+ * objv - argument array.
+ * flags - unused
+ *
+ * Returns the list of elements of the vector in objv[2] or the element at
+ * index objv[3] if specified. A trailing -type option permits a value that
+ * is no longer a vector to be converted back to one.
+ *
+ * Returns:
+ * *TCL_OK* on success with the value as interpreter result,
+ * *TCL_ERROR* on failure with error message in interpreter.
+ */
+static CffiResult
+CffiVectorGetCmd(CffiInterpCtx *ipCtxP,
+                 int objc,
+                 Tcl_Obj *const objv[],
+                 CffiFlags flags)
+{
+    Tcl_Interp *ip = ipCtxP->interp;
+    CffiVector *vecP;
+    char *dataP;
+    Tcl_Obj *listObj;
+    Tcl_Obj *elemObj;
+    Tcl_Obj *typeObj;
+    Tcl_Size indx = 0;
+
+    CHECK(CffiVectorTypeOption(ip, &objc, objv, 3, 4, &typeObj));
+    if (objc > 3)
+        CHECK(CffiVectorIndexFromObj(ip, objv[3], &indx));
+    CHECK(CffiVectorFromObj(ipCtxP, objv[2], typeObj, &vecP));
+    dataP = objv[2]->internalRep.twoPtrValue.ptr2;
+    if (objc < 4) {
+        Tcl_SetObjResult(
+            ip, CffiNumericArrayToObj(vecP->baseType, dataP, vecP->count));
+        return TCL_OK;
+    }
+
+    CHECK(CffiVectorIndexCheck(ip, vecP, objv[3], indx));
+    /* Wrap a single element array and extract the element */
+    listObj = CffiNumericArrayToObj(
+        vecP->baseType, dataP + indx * vecP->elemSize, 1);
+    Tcl_IncrRefCount(listObj);
+    Tcl_ListObjIndex(NULL, listObj, 0, &elemObj);
+    Tcl_SetObjResult(ip, elemObj);
+    Tcl_DecrRefCount(listObj);
+    return TCL_OK;
+}
+
+/* Function: CffiVectorSetCmd
+ * Implements the *vector set* script level command.
+ *
+ * Parameters:
+ * ipCtxP - interpreter context
+ * objc - count of elements in objv[]. Should be 5 or 7 including command
+ *        and subcommand.
+ * objv - argument array.
+ * flags - unused
+ *
+ * Stores the value objv[4] at index objv[3] of the vector held in the
+ * variable named by objv[2]. As for *lset*, the vector is duplicated
+ * first if shared. A trailing -type option permits a value that is no
+ * longer a vector to be converted back to one.
+ *
+ * Returns:
+ * *TCL_OK* on success with the modified vector as interpreter result,
+ * *TCL_ERROR* on failure with error message in interpreter.
+ */
+static CffiResult
+CffiVectorSetCmd(CffiInterpCtx *ipCtxP,
+                 int objc,
+                 Tcl_Obj *const objv[],
+                 CffiFlags flags)
+{
+    Tcl_Interp *ip = ipCtxP->interp;
+    CffiVector *vecP;
+    Tcl_Obj *vecObj;
+    Tcl_Obj *valueObj;
+    Tcl_Obj *resultObj;
+    Tcl_Obj *typeObj;
+    Tcl_Size indx;
+    CffiResult ret;
+    union {
+        long long ll;
+        double dbl;
+    } elem; /* Large and aligned enough for any numeric type */
+
+    CHECK(CffiVectorTypeOption(ip, &objc, objv, 5, 5, &typeObj));
+    CHECK(CffiVectorIndexFromObj(ip, objv[3], &indx));
+    vecObj = Tcl_ObjGetVar2(ip, objv[2], NULL, TCL_LEAVE_ERR_MSG);
+    if (vecObj == NULL)
+        return TCL_ERROR;
+    CHECK(CffiVectorFromObj(ipCtxP, vecObj, typeObj, &vecP));
+    CHECK(CffiVectorIndexCheck(ip, vecP, objv[3], indx));
+    /*
+     * Convert before duplicating so the variable is unchanged on error.
+     * Convert a copy if the value is the vector itself so its internal
+     * representation is not freed.
+     */
+    valueObj = objv[4] == vecObj ? Tcl_DuplicateObj(objv[4]) : objv[4];
+    Tcl_IncrRefCount(valueObj);
+    ret = CffiNumericArrayFromObjs(ip, vecP->baseType, &valueObj, 1, &elem);
+    Tcl_DecrRefCount(valueObj);
+    if (ret != TCL_OK)
+        return ret;
+
+    if (Tcl_IsShared(vecObj)) {
+        vecObj = Tcl_DuplicateObj(vecObj);
+        vecP   = (CffiVector *)vecObj->internalRep.twoPtrValue.ptr1;
+    }
+    memcpy(indx * vecP->elemSize + (char *)vecObj->internalRep.twoPtrValue.ptr2,
+           &elem,
+           vecP->elemSize);
+    Tcl_InvalidateStringRep(vecObj);
+
+    resultObj = Tcl_ObjSetVar2(ip, objv[2], NULL, vecObj, TCL_LEAVE_ERR_MSG);
+    if (resultObj == NULL)
+        return TCL_ERROR;
+    Tcl_SetObjResult(ip, resultObj);
+    return TCL_OK;
+}
+
+/* Function: CffiVectorSliceCmd
+ * Implements the *vector slice* script level command.
+ *
+ * Parameters:
+ * ipCtxP - interpreter context
+ * objc - count of elements in objv[]. Should be 4-7 including command
+ *        and subcommand.
+ * objv - argument array.
+ * flags - unused
+ *
+ * Returns a new vector containing the elements of the vector objv[2]
+ * from index objv[3] to objv[4] inclusive. As for *lrange*, the range is
+ * clipped to the vector and defaults to the last element. A trailing -type
+ * option permits a value that is no longer a vector to be converted back
+ * to one.
+ *
+ * Returns:
+ * *TCL_OK* on success with the new vector as interpreter result,
+ * *TCL_ERROR* on failure with error message in interpreter.
+ */
+static CffiResult
+CffiVectorSliceCmd(CffiInterpCtx *ipCtxP,
+                   int objc,
+                   Tcl_Obj *const objv[],
+                   CffiFlags flags)
+{
+    Tcl_Interp *ip = ipCtxP->interp;
+    CffiVector *vecP;
+    Tcl_Obj *typeObj;
+    Tcl_WideInt first, last = -1;
+
+    /* Indices are parsed first as they may share the vector Tcl_Obj */
+    CHECK(CffiVectorTypeOption(ip, &objc, objv, 4, 5, &typeObj));
+    CHECK(Tclh_ObjToRangedInt(ip, objv[3], 0, INT_MAX, &first));
+    if (objc > 4)
+        CHECK(Tclh_ObjToRangedInt(ip, objv[4], -1, INT_MAX, &last));
+    CHECK(CffiVectorFromObj(ipCtxP, objv[2], typeObj, &vecP));
+    if (objc <= 4 || last >= vecP->count)
+        last = vecP->count - 1;
+
+    if (first > last) {
+        Tcl_SetObjResult(ip, CffiVectorNewObj(vecP->baseType, NULL, 0));
+    }
+    else {
+        Tcl_SetObjResult(
+            ip,
+            CffiVectorNewObj(vecP->baseType,
+                             first * vecP->elemSize
+                                 + (char *)objv[2]->internalRep.twoPtrValue.ptr2,
+                             (Tcl_Size)(last - first + 1)));
+    }
+    return TCL_OK;
+}
+
+/* Function: CffiVectorInfoCmd
+ * Implements the *vector info* script level command.
+ *
+ * Parameters:
+ * ipCtxP - interpreter context
+ * objc - count of elements in objv[]. Should be 3 or 5 including command
+ *        and subcommand.
+ * objv - argument array.
+ * flags - unused
+ *
+ * A trailing -type option permits a value that is no longer a vector to be
+ * converted back to one.
+ *
+ * Returns:
+ * *TCL_OK* on success with a dictionary containing the element type and
+ * count of the vector as interpreter result, *TCL_ERROR* on failure with
+ * error message in interpreter.
+ */
+static CffiResult
+CffiVectorInfoCmd(CffiInterpCtx *ipCtxP,
+                  int objc,
+                  Tcl_Obj *const objv[],
+                  CffiFlags flags)
+{
+    Tcl_Interp *ip = ipCtxP->interp;
+    CffiVector *vecP;
+    Tcl_Obj *objs[4];
+    Tcl_Obj *typeObj;
+
+    CHECK(CffiVectorTypeOption(ip, &objc, objv, 3, 3, &typeObj));
+    CHECK(CffiVectorFromObj(ipCtxP, objv[2], typeObj, &vecP));
+    objs[0] = Tcl_NewStringObj("type", 4);
+    objs[1] = Tcl_NewStringObj(cffiBaseTypes[vecP->baseType].token, -1);
+    objs[2] = Tcl_NewStringObj("count", 5);
+    objs[3] = Tcl_NewWideIntObj(vecP->count);
+    Tcl_SetObjResult(ip, Tcl_NewListObj(4, objs));
+    return TCL_OK;
+}
+
+/* Function: CffiVectorObjCmd
+ * Implements the *cffi::vector* script level command.
+ *
+ * Parameters:
+ * cdata - interpreter context
+ * ip - interpreter
+ * objc - number of elements in *objv*
+ * objv - array containing the command and arguments
+ *
+ * Returns:
+ * Returns TCL_OK on success and TCL_ERROR on failure with error message
+ * in the interpreter.
+ */
+CffiResult
+CffiVectorObjCmd(ClientData cdata,
+                 Tcl_Interp *ip,
+                 int objc,
+                 Tcl_Obj *const objv[])
+{
+    CffiInterpCtx *ipCtxP = (CffiInterpCtx *)cdata;
+    static const Tclh_SubCommand subCommands[] = {
+        {"get", 1, 4, "VECTOR ?INDEX? ?-type TYPE?", CffiVectorGetCmd, 0},
+        {"info", 1, 3, "VECTOR ?-type TYPE?", CffiVectorInfoCmd, 0},
+        {"new", 1, 2, "TYPE ?INITIALIZER?", CffiVectorNewCmd, 0},
+        {"set", 3, 5, "VARNAME INDEX VALUE ?-type TYPE?", CffiVectorSetCmd, 0},
+        {"slice", 2, 5, "VECTOR FIRST ?LAST? ?-type TYPE?", CffiVectorSliceCmd, 0},
+        {NULL}
+    };
+    int cmdIndex;
+
+    CHECK(Tclh_SubCommandLookup(ip, subCommands, objc, objv, &cmdIndex));
+    return subCommands[cmdIndex].cmdFn(
+        ipCtxP, objc, objv, subCommands[cmdIndex].flags);
+}